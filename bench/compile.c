@@ -0,0 +1,536 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#ifndef _WIN32
+	// Объявления mkstemp и wait4
+	#define _DEFAULT_SOURCE
+#endif
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "codegen.h"
+#include "compiler.h"
+#include "llvmgen.h"
+#include "macro.h"
+#include "mipsgen.h"
+#include "parser.h"
+#include "riscvgen.h"
+#include "syntax.h"
+#include "uniio.h"
+#include "workspace.h"
+
+#ifndef _WIN32
+	#include <sys/resource.h>
+	#include <sys/wait.h>
+	#include <unistd.h>
+#endif
+
+
+#define MAX_PATH_SIZE 1024
+
+static const size_t DEFAULT_FUNCTIONS = 1000;
+static const size_t DEFAULT_NESTING_DEPTH = 32;
+static const size_t DEFAULT_SWITCH_CASES = 64;
+static const size_t DEFAULT_TABLE_SIZE = 256;
+static const size_t DEFAULT_MACRO_CALLS = 8;
+static const size_t DEFAULT_INCLUDES = 16;
+
+static const char *const USAGE =
+	"usage: ruc-bench [-f functions] [-d nesting_depth] [-s switch_cases] [-t table_size]"
+	" [-m macro_calls] [-i includes] [-o report]\n";
+
+
+/** Shape of generated program */
+typedef struct parameters
+{
+	size_t functions;			/**< Number of functions */
+	size_t nesting_depth;		/**< Depth of nested blocks in each function */
+	size_t switch_cases;		/**< Number of cases in switch of each function */
+	size_t table_size;			/**< Size of global table of each function */
+	size_t macro_calls;			/**< Number of extra macro calls in each function */
+	size_t includes;			/**< Number of includes of header with macros, @c 0 to define them in place */
+} parameters;
+
+
+typedef int (*encoder)(const workspace *const ws, syntax *const sx, const layout *const lt);
+
+/** Backend under measurement */
+typedef struct backend
+{
+	const char *name;			/**< Backend name in report */
+	encoder enc;				/**< Encoding function */
+	size_t word_size;			/**< Size of non-floating scalar types, @c 0 if layout is not used */
+	size_t floating_size;		/**< Size of floating types */
+} backend;
+
+static const backend BACKENDS[] =
+{
+	{ "vm", &encode_to_vm, VM_WORD_SIZE, VM_FLOATING_SIZE },
+	{ "llvm", &encode_to_llvm, 0, 0 },
+	{ "mips", &encode_to_mips, MIPS_WORD_SIZE, MIPS_FLOATING_SIZE },
+	{ "riscv", &encode_to_riscv, RISCV_WORD_SIZE, RISCV_FLOATING_SIZE },
+};
+
+/** Way of compilation under measurement */
+typedef enum PIPELINE
+{
+	PIPELINE_STAGES,			/**< Stage by stage, as done in compile_from_ws */
+	PIPELINE_BUFFER,			/**< By compiler, preprocessed text is kept in buffer */
+	PIPELINE_STREAM,			/**< By compiler with @c -stream flag */
+} pipeline_t;
+
+/** Measured stages of single compilation */
+typedef struct stages
+{
+	double wall;				/**< Wall clock time of compilation by compiler */
+	double macro;				/**< Preprocessing time */
+	double parse;				/**< Parsing time */
+	double check;				/**< Time of sx_is_correct */
+	double layout;				/**< Time of type layout computation */
+	double encode;				/**< Code generation time */
+	size_t include_hits;		/**< Number of include path checks without file system access */
+	size_t allocations;			/**< Number of allocation requests of syntax tables */
+	size_t chunks;				/**< Number of system allocations for syntax tables */
+	long peak_rss;				/**< Peak resident set size of compilation in KB */
+	int status;					/**< @c 0 on success, number of failed stage otherwise */
+} stages;
+
+
+static void generate_function(FILE *const file, const parameters *const params, const size_t index)
+{
+	fprintf(file, "int table_%zu[%zu] = { ", index, params->table_size);
+	for (size_t i = 0; i < params->table_size; i++)
+	{
+		fprintf(file, "%s%zu", i == 0 ? "" : ", ", (index * 31 + i * 17) % 1000);
+	}
+	fprintf(file, " };\n\n");
+
+	fprintf(file, "int function_%zu(int x)\n{\n\tint result = %zu;\n", index, index);
+
+	// Вложенные блоки с локальными переменными
+	for (size_t i = 0; i < params->nesting_depth; i++)
+	{
+		fprintf(file, "%*s{\n%*sint v_%zu = x + %zu;\n%*sif (v_%zu > %zu)\n"
+			, (int)i + 1, "", (int)i + 2, "", i, i, (int)i + 2, "", i, i);
+	}
+	fprintf(file, "%*sresult = result + CLAMP(x, 0, %zu);\n", (int)params->nesting_depth + 2, "", index);
+	for (size_t i = params->nesting_depth; i > 0; i--)
+	{
+		fprintf(file, "%*s}\n", (int)i, "");
+	}
+
+	// Макровызовы с вложенными подстановками
+	for (size_t i = 0; i < params->macro_calls; i++)
+	{
+		fprintf(file, "\tSTEP(result, CLAMP(SQUARE(x %% %zu), %zu, %zu));\n", i + 2, i, i + 100);
+	}
+
+	if (params->switch_cases != 0)
+	{
+		fprintf(file, "\n\tswitch (x %% %zu)\n\t{\n", params->switch_cases);
+		for (size_t i = 0; i < params->switch_cases; i++)
+		{
+			fprintf(file, "\t\tcase %zu:\n\t\t\tSTEP(result, x + %zu);\n\t\t\tbreak;\n", i, i);
+		}
+		fprintf(file, "\t\tdefault:\n\t\t\tresult = -result;\n\t}\n");
+	}
+
+	if (params->table_size != 0)
+	{
+		fprintf(file, "\n\treturn result + table_%zu[x %% %zu];\n}\n\n", index, params->table_size);
+	}
+	else
+	{
+		fprintf(file, "\n\treturn result;\n}\n\n");
+	}
+}
+
+static void generate_macros(FILE *const file)
+{
+	fprintf(file, "#define SQUARE(x) ((x) * (x))\n");
+	fprintf(file, "#define CLAMP(x, lo, hi) ((x) < (lo) ? (lo) : (x) > (hi) ? (hi) : (x))\n");
+	fprintf(file, "#define STEP(acc, x) acc = acc + SQUARE(x) %% 7 + CLAMP(x, 1, 9)\n\n");
+}
+
+/** Generate header with macros, which is included from the same directory */
+static int generate_header(const char *const path)
+{
+	FILE *const file = fopen(path, "w");
+	if (file == NULL)
+	{
+		return -1;
+	}
+
+	generate_macros(file);
+	return fclose(file);
+}
+
+/** Generate program of given shape */
+static int generate(const char *const path, const char *const header, const parameters *const params)
+{
+	FILE *const file = fopen(path, "w");
+	if (file == NULL)
+	{
+		return -1;
+	}
+
+	// Повторные подключения заголовка проверяют уже известный путь
+	const char *name = strrchr(header, '/');
+	name = name != NULL ? name + 1 : header;
+	for (size_t i = 0; i < params->includes; i++)
+	{
+		fprintf(file, "#include \"%s\"\n", name);
+	}
+
+	if (params->includes == 0)
+	{
+		generate_macros(file);
+	}
+	else
+	{
+		fprintf(file, "\n");
+	}
+
+	for (size_t i = 0; i < params->functions; i++)
+	{
+		generate_function(file, params, i);
+	}
+
+	fprintf(file, "int main()\n{\n\tint total = 0;\n");
+	for (size_t i = 0; i < params->functions; i++)
+	{
+		fprintf(file, "\ttotal = total + function_%zu(%zu);\n", i, i);
+	}
+	fprintf(file, "\tprintf(\"%%i\\n\", total);\n\treturn 0;\n}\n");
+
+	return fclose(file);
+}
+
+/** Create empty temporary file and write its path to buffer */
+static int make_temp_file(char *const path, const char *const name)
+{
+#ifndef _WIN32
+	const char *const directory = getenv("TMPDIR");
+	snprintf(path, MAX_PATH_SIZE, "%s/%s-XXXXXX", directory != NULL ? directory : "/tmp", name);
+
+	const int descriptor = mkstemp(path);
+	return descriptor != -1 ? close(descriptor) : -1;
+#else
+	(void)name;
+	return tmpnam(path) != NULL ? 0 : -1;
+#endif
+}
+
+
+static inline double seconds_since(const clock_t begin)
+{
+	return (double)(clock() - begin) / CLOCKS_PER_SEC;
+}
+
+/** Wall clock time, since processor time of both threads is counted by clock */
+static inline double wall_time(void)
+{
+#ifndef _WIN32
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (double)time.tv_sec + (double)time.tv_nsec / 1000000000.0;
+#else
+	return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/** Compile program stage by stage, as done in compile_from_ws */
+static stages measure(const char *const path, const char *const output, const backend *const bk)
+{
+	stages result = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0, 0, 0, 0 };
+
+	workspace ws = ws_create();
+	ws_add_file(&ws, path);
+
+	clock_t begin = clock();
+	char *const preprocessing = macro_with_hits(&ws, &result.include_hits);
+	result.macro = seconds_since(begin);
+	if (preprocessing == NULL)
+	{
+		result.status = 1;
+		ws_clear(&ws);
+		return result;
+	}
+
+	universal_io io = io_create();
+	in_set_buffer(&io, preprocessing);
+	out_set_file(&io, output);
+
+	syntax sx = sx_create(&ws, &io);
+
+	begin = clock();
+	result.status = parse(&sx) ? 2 : 0;
+	result.parse = seconds_since(begin);
+
+	if (result.status == 0)
+	{
+		begin = clock();
+		result.status = sx_is_correct(&sx) ? 0 : 3;
+		result.check = seconds_since(begin);
+	}
+
+	if (result.status == 0)
+	{
+		begin = clock();
+		layout lt = layout_create(&sx, bk->word_size, bk->floating_size);
+		result.layout = seconds_since(begin);
+
+		begin = clock();
+		result.status = bk->enc(&ws, &sx, bk->word_size != 0 ? &lt : NULL) ? 4 : 0;
+		result.encode = seconds_since(begin);
+
+		layout_clear(&lt);
+	}
+
+	result.allocations = arena_get_allocations(sx.region);
+	result.chunks = arena_get_chunks(sx.region);
+
+	sx_clear(&sx);
+	io_erase(&io);
+	free(preprocessing);
+	ws_clear(&ws);
+
+	return result;
+}
+
+/** Compile program to virtual machine code by compiler, preprocessing is done on worker thread in stream mode */
+static stages measure_compile(const char *const path, const char *const output, const bool is_streamed)
+{
+	stages result = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0, 0, 0, 0 };
+
+	workspace ws = ws_create();
+	ws_add_file(&ws, path);
+	ws_set_output(&ws, output);
+	if (is_streamed)
+	{
+		ws_add_flag(&ws, "-stream");
+	}
+
+	const double begin = wall_time();
+	result.status = compile_to_vm(&ws) == sts_success ? 0 : 1;
+	result.wall = wall_time() - begin;
+
+	ws_clear(&ws);
+	return result;
+}
+
+static stages measure_pipeline(const char *const path, const char *const output, const backend *const bk
+	, const pipeline_t pipeline)
+{
+	return pipeline == PIPELINE_STAGES
+		? measure(path, output, bk)
+		: measure_compile(path, output, pipeline == PIPELINE_STREAM);
+}
+
+/**
+ *	Measure compilation in separate process,
+ *	since the peak resident set size is a high-water mark of the whole process
+ */
+static stages measure_isolated(const char *const path, const char *const output, const backend *const bk
+	, const pipeline_t pipeline)
+{
+#ifndef _WIN32
+	stages result = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0, 0, 0, 5 };
+
+	int channel[2];
+	if (pipe(channel) != 0)
+	{
+		return result;
+	}
+
+	fflush(NULL);
+	const pid_t child = fork();
+	if (child == 0)
+	{
+		close(channel[0]);
+		const stages measured = measure_pipeline(path, output, bk, pipeline);
+		const ssize_t written = write(channel[1], &measured, sizeof(stages));
+		_exit(written == (ssize_t)sizeof(stages) ? 0 : 1);
+	}
+
+	close(channel[1]);
+	if (child == -1)
+	{
+		close(channel[0]);
+		return result;
+	}
+
+	stages measured;
+	const bool is_received = read(channel[0], &measured, sizeof(stages)) == (ssize_t)sizeof(stages);
+	close(channel[0]);
+
+	int status;
+	struct rusage usage;
+	if (wait4(child, &status, 0, &usage) != child)
+	{
+		return result;
+	}
+
+	// Упавший процесс считается отдельной стадией
+	if (is_received && WIFEXITED(status) && WEXITSTATUS(status) == 0)
+	{
+		result = measured;
+	}
+
+	result.peak_rss = usage.ru_maxrss;
+	return result;
+#else
+	return measure_pipeline(path, output, bk, pipeline);
+#endif
+}
+
+
+static int parse_arguments(const int argc, const char *argv[], parameters *const params, const char **const report)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 == argc)
+		{
+			return -1;
+		}
+
+		const char *const value = argv[++i];
+		switch (argv[i - 1][1])
+		{
+			case 'f':
+				params->functions = (size_t)atoi(value);
+				break;
+			case 'd':
+				params->nesting_depth = (size_t)atoi(value);
+				break;
+			case 's':
+				params->switch_cases = (size_t)atoi(value);
+				break;
+			case 't':
+				params->table_size = (size_t)atoi(value);
+				break;
+			case 'm':
+				params->macro_calls = (size_t)atoi(value);
+				break;
+			case 'i':
+				params->includes = (size_t)atoi(value);
+				break;
+			case 'o':
+				*report = value;
+				break;
+			default:
+				return -1;
+		}
+	}
+
+	return 0;
+}
+
+
+int main(int argc, const char *argv[])
+{
+	parameters params = { DEFAULT_FUNCTIONS, DEFAULT_NESTING_DEPTH, DEFAULT_SWITCH_CASES
+		, DEFAULT_TABLE_SIZE, DEFAULT_MACRO_CALLS, DEFAULT_INCLUDES };
+	const char *report_path = NULL;
+	if (parse_arguments(argc, argv, &params, &report_path))
+	{
+		fprintf(stderr, "%s", USAGE);
+		return 1;
+	}
+
+	FILE *const report = report_path != NULL ? fopen(report_path, "w") : stdout;
+	if (report == NULL)
+	{
+		fprintf(stderr, "cannot open %s\n", report_path);
+		return 1;
+	}
+
+	char source_path[MAX_PATH_SIZE];
+	char header_path[MAX_PATH_SIZE];
+	char output_path[MAX_PATH_SIZE];
+	if (make_temp_file(source_path, "ruc-bench-source") || make_temp_file(header_path, "ruc-bench-header")
+		|| make_temp_file(output_path, "ruc-bench-output"))
+	{
+		fprintf(stderr, "cannot create temporary files\n");
+		return 1;
+	}
+
+	if (generate_header(header_path) || generate(source_path, header_path, &params))
+	{
+		fprintf(stderr, "cannot write %s\n", source_path);
+		remove(source_path);
+		remove(header_path);
+		remove(output_path);
+		return 1;
+	}
+
+	long source_size = 0;
+	FILE *const source = fopen(source_path, "rb");
+	if (source != NULL)
+	{
+		fseek(source, 0, SEEK_END);
+		source_size = ftell(source);
+		fclose(source);
+	}
+
+	fprintf(report, "{\n\t\"functions\": %zu,\n\t\"nesting_depth\": %zu,\n\t\"switch_cases\": %zu"
+		",\n\t\"table_size\": %zu,\n\t\"macro_calls\": %zu,\n\t\"includes\": %zu,\n\t\"source_bytes\": %ld"
+		",\n\t\"backends\": [\n"
+		, params.functions, params.nesting_depth, params.switch_cases, params.table_size, params.macro_calls
+		, params.includes, source_size);
+
+	int ret = 0;
+	const size_t backends = sizeof(BACKENDS) / sizeof(backend);
+	for (size_t i = 0; i < backends; i++)
+	{
+		const stages result = measure_isolated(source_path, output_path, &BACKENDS[i], PIPELINE_STAGES);
+		ret = ret || result.status != 0;
+
+		fprintf(report, "\t\t{ \"backend\": \"%s\", \"status\": %d, \"macro\": %.6f, \"parse\": %.6f"
+			", \"sx_is_correct\": %.6f, \"layout\": %.6f, \"encode\": %.6f, \"total\": %.6f, \"include_hits\": %zu"
+			", \"allocations\": %zu, \"system_allocations\": %zu, \"peak_rss_kb\": %ld }%s\n"
+			, BACKENDS[i].name, result.status, result.macro, result.parse, result.check, result.layout, result.encode
+			, result.macro + result.parse + result.check + result.layout + result.encode, result.include_hits
+			, result.allocations, result.chunks, result.peak_rss
+			, i + 1 < backends ? "," : "");
+	}
+
+	// Сравнение полной компиляции с препроцессированием в буфер и в поток
+	fprintf(report, "\t],\n\t\"pipeline\": [\n");
+	for (pipeline_t pipeline = PIPELINE_BUFFER; pipeline <= PIPELINE_STREAM; pipeline++)
+	{
+		const stages result = measure_isolated(source_path, output_path, &BACKENDS[0], pipeline);
+		ret = ret || result.status != 0;
+
+		fprintf(report, "\t\t{ \"mode\": \"%s\", \"status\": %d, \"wall\": %.6f, \"peak_rss_kb\": %ld }%s\n"
+			, pipeline == PIPELINE_STREAM ? "stream" : "buffer", result.status, result.wall, result.peak_rss
+			, pipeline != PIPELINE_STREAM ? "," : "");
+	}
+
+	fprintf(report, "\t]\n}\n");
+	if (report != stdout)
+	{
+		fclose(report);
+	}
+
+	remove(source_path);
+	remove(header_path);
+	remove(output_path);
+	return ret;
+}
@@ -0,0 +1,186 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "decimal.h"
+
+
+static const size_t DEFAULT_SIZE = 1024;
+static const size_t LITERAL_SIZE = 32;
+
+
+typedef double (*converter)(const char *const str, const char **const end);
+
+
+/** Conversion as done by lexer before decimal module */
+static double convert_by_powers(const char *const str, const char **const end)
+{
+	const char *ptr = str;
+	double value = 0.0;
+	while (*ptr >= '0' && *ptr <= '9')
+	{
+		value = value * 10 + (*ptr++ - '0');
+	}
+
+	if (*ptr == '.')
+	{
+		double position_mult = 0.1;
+		while (*++ptr >= '0' && *ptr <= '9')
+		{
+			value += (*ptr - '0') * position_mult;
+			position_mult *= 0.1;
+		}
+	}
+
+	if (*ptr == 'e')
+	{
+		const int sign = *++ptr == '-' ? -1 : 1;
+		ptr += *ptr == '-' ? 1 : 0;
+
+		int64_t power = 0;
+		while (*ptr >= '0' && *ptr <= '9')
+		{
+			power = power * 10 + (*ptr++ - '0');
+		}
+
+		value *= pow(10.0, sign * (double)power);
+	}
+
+	*end = ptr;
+	return value;
+}
+
+static double convert_by_decimal(const char *const str, const char **const end)
+{
+	const char *ptr = str;
+	decimal dec = decimal_create();
+	while (*ptr >= '0' && *ptr <= '9')
+	{
+		decimal_add_digit(&dec, (uint8_t)(*ptr++ - '0'));
+	}
+
+	if (*ptr == '.')
+	{
+		while (*++ptr >= '0' && *ptr <= '9')
+		{
+			decimal_add_fraction(&dec, (uint8_t)(*ptr - '0'));
+		}
+	}
+
+	if (*ptr == 'e')
+	{
+		const int sign = *++ptr == '-' ? -1 : 1;
+		ptr += *ptr == '-' ? 1 : 0;
+
+		int64_t power = 0;
+		while (*ptr >= '0' && *ptr <= '9')
+		{
+			power = power * 10 + (*ptr++ - '0');
+		}
+
+		dec.exponent += sign * power;
+	}
+
+	*end = ptr;
+	return decimal_to_double(&dec, str);
+}
+
+static double convert_by_strtod(const char *const str, const char **const end)
+{
+	return strtod(str, (char **)end);
+}
+
+
+/** Float literals like in generated tables: 0.1, 3.14159, 6.02e23, 1.5e-7 */
+static char *generate(const size_t count)
+{
+	char *const text = malloc(count * LITERAL_SIZE + 1);
+	if (text == NULL)
+	{
+		return NULL;
+	}
+
+	size_t index = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		const unsigned digits = 2 + (unsigned)rand() % 17;
+		const unsigned point = (unsigned)rand() % digits;
+		for (unsigned j = 0; j < digits; j++)
+		{
+			text[index++] = j == point ? '.' : (char)('0' + rand() % 10);
+		}
+
+		if (rand() % 4 == 0)
+		{
+			index += (size_t)sprintf(&text[index], "e%s%d", rand() % 2 ? "-" : "", rand() % 300);
+		}
+
+		text[index++] = ' ';
+	}
+
+	text[index] = '\0';
+	return text;
+}
+
+static void measure(const char *const name, const char *const text, const converter func)
+{
+	const clock_t begin = clock();
+
+	size_t count = 0;
+	double checksum = 0.0;
+	for (const char *ptr = text; *ptr != '\0'; ptr++)
+	{
+		checksum += func(ptr, &ptr);
+		count++;
+	}
+
+	const double seconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+
+	// Сверка со strtod вне замера
+	size_t inexact = 0;
+	for (const char *ptr = text; *ptr != '\0'; ptr++)
+	{
+		const double expected = strtod(ptr, NULL);
+		const double value = func(ptr, &ptr);
+		inexact += memcmp(&value, &expected, sizeof(double)) != 0 ? 1 : 0;
+	}
+
+	printf("%-8s %10zu literals %10zu inexact %8.2f ns/literal  sum %g\n", name, count, inexact
+		, seconds * 1e9 / (double)count, checksum);
+}
+
+
+int main(int argc, const char *argv[])
+{
+	const size_t thousands = argc > 1 ? (size_t)atoi(argv[1]) : DEFAULT_SIZE;
+	char *const text = generate(thousands * 1024);
+	if (text == NULL)
+	{
+		fprintf(stderr, "cannot allocate %zu literals\n", thousands * 1024);
+		return 1;
+	}
+
+	measure("powers", text, &convert_by_powers);
+	measure("decimal", text, &convert_by_decimal);
+	measure("strtod", text, &convert_by_strtod);
+
+	free(text);
+	return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lexer.h"
+#include "simd.h"
+#include "workspace.h"
+
+
+static const size_t DEFAULT_SIZE = 8;
+
+static const char *const SAMPLE =
+	"/*\n"
+	" *\t================================================================\n"
+	" *\tСгенерированная функция, не редактировать вручную\n"
+	" *\t================================================================\n"
+	" */\n"
+	"void функция()\n"
+	"{\n"
+	"\t\t\t\tint переменная_1 = 42;                    // счётчик\n"
+	"\t\t\t\tif (переменная_1 > 0)\n"
+	"\t\t\t\t{\n"
+	"\t\t\t\t\t\t\t\tпеременная_1 = переменная_1 * 2 + 1;    // удвоение\n"
+	"\t\t\t\t}\n"
+	"}\n\n";
+
+static const char *const LEVELS[] = { "before", "scalar", "sse2", "avx2" };
+
+
+static char *generate(const size_t size)
+{
+	const size_t length = strlen(SAMPLE);
+	char *const text = malloc(size + 1);
+	if (text == NULL)
+	{
+		return NULL;
+	}
+
+	size_t index = 0;
+	while (index + length <= size)
+	{
+		memcpy(&text[index], SAMPLE, length);
+		index += length;
+	}
+
+	text[index] = '\0';
+	return text;
+}
+
+static void measure(const simd_level level, const workspace *const ws, const char *const text, const size_t size)
+{
+	universal_io io = io_create();
+	in_set_buffer(&io, text);
+
+	syntax sx = sx_create(ws, &io);
+	lexer lxr = lexer_create(&sx);
+
+	const clock_t begin = clock();
+
+	size_t tokens = 0;
+	for (token tk = lex(&lxr); !token_is(&tk, TK_EOF); tk = lex(&lxr))
+	{
+		tokens++;
+	}
+
+	const double seconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+	printf("%-8s %12zu tokens  %12.0f tokens/s  %10.2f MB/s\n", LEVELS[level], tokens
+		, seconds > 0 ? (double)tokens / seconds : 0.0
+		, seconds > 0 ? (double)size / (1024 * 1024) / seconds : 0.0);
+
+	lexer_clear(&lxr);
+	sx_clear(&sx);
+	io_erase(&io);
+}
+
+
+int main(int argc, const char *argv[])
+{
+	const size_t megabytes = argc > 1 ? (size_t)atoi(argv[1]) : DEFAULT_SIZE;
+	char *const text = generate(megabytes * 1024 * 1024);
+	if (text == NULL)
+	{
+		fprintf(stderr, "cannot allocate %zu MB\n", megabytes);
+		return 1;
+	}
+
+	workspace ws = ws_create();
+	const size_t size = strlen(text);
+	for (simd_level level = SIMD_NONE; level <= SIMD_AVX2; level++)
+	{
+		if (simd_set_level(level) == 0)
+		{
+			measure(level, &ws, text, size);
+		}
+	}
+
+	ws_clear(&ws);
+	free(text);
+	return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "map.h"
+
+
+static const size_t DEFAULT_SIZE = 256;
+static const size_t KEY_SIZE = 32;
+static const size_t TABLE_MIN = 16;
+static const size_t OPERATIONS = 1000000;
+
+
+/** Identifier-like keys, which are anagrams of each other: a1, b0, x_1, y_0 */
+static void generate(char *const buffer, const size_t index, const char first)
+{
+	sprintf(buffer, "%c%s%zu", first + (char)(index % 26), index % 52 < 26 ? "" : "_", index / 52);
+}
+
+static double elapsed(const clock_t begin, const size_t count)
+{
+	return (double)(clock() - begin) / CLOCKS_PER_SEC * 1e9 / (double)count;
+}
+
+static char *generate_all(const size_t count, const char first)
+{
+	char *const keys = malloc(count * KEY_SIZE);
+	if (keys != NULL)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			generate(&keys[i * KEY_SIZE], i, first);
+		}
+	}
+
+	return keys;
+}
+
+static int measure(const size_t count, const char *const keys, const char *const others)
+{
+	// Маленькие таблицы заполняются повторно, чтобы замер был не короче OPERATIONS обращений
+	const size_t rounds = count < OPERATIONS ? OPERATIONS / count : 1;
+	map as = map_create(1);
+
+	clock_t begin = clock();
+	for (size_t round = 0; round < rounds; round++)
+	{
+		map_clear(&as);
+		as = map_create(1);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			if (map_add(&as, &keys[i * KEY_SIZE], (item_t)i) != i)
+			{
+				fprintf(stderr, "cannot add %s\n", &keys[i * KEY_SIZE]);
+				map_clear(&as);
+				return -1;
+			}
+		}
+	}
+	const double insert = elapsed(begin, rounds * count);
+
+	item_t checksum = 0;
+	begin = clock();
+	for (size_t round = 0; round < rounds; round++)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			checksum += map_get(&as, &keys[i * KEY_SIZE]);
+		}
+	}
+	const double hit = elapsed(begin, rounds * count);
+
+	size_t misses = 0;
+	begin = clock();
+	for (size_t round = 0; round < rounds; round++)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			misses += map_get(&as, &others[i * KEY_SIZE]) == ITEM_MAX;
+		}
+	}
+	const double miss = elapsed(begin, rounds * count);
+
+	const bool correct = checksum == (item_t)(rounds * count * (count - 1) / 2) && misses == rounds * count;
+	printf("%10zu keys %10zu slots %5.1f%% load  %7.1f ns insert %7.1f ns hit %7.1f ns miss  %s\n"
+		, count, as.table_size, 100.0 * (double)count / (double)as.table_size, insert, hit, miss
+		, correct ? "ok" : "wrong");
+
+	map_clear(&as);
+	return 0;
+}
+
+
+int main(int argc, const char *argv[])
+{
+	const size_t thousands = argc > 1 ? (size_t)atoi(argv[1]) : DEFAULT_SIZE;
+	const size_t limit = thousands * 1024;
+
+	char *const keys = generate_all(limit, 'a');
+	char *const others = generate_all(limit, 'A');
+	if (keys == NULL || others == NULL)
+	{
+		fprintf(stderr, "cannot allocate %zu keys\n", limit);
+		free(keys);
+		free(others);
+		return 1;
+	}
+
+	int ret = 0;
+	// Замеры непосредственно до и после каждого увеличения таблицы
+	for (size_t slots = TABLE_MIN * 2; slots * MAP_LOAD_FACTOR / 100 <= limit; slots *= 2)
+	{
+		const size_t threshold = slots * MAP_LOAD_FACTOR / 200;
+		if (measure(threshold, keys, others) || measure(threshold + 1, keys, others))
+		{
+			ret = 1;
+			break;
+		}
+	}
+
+	free(keys);
+	free(others);
+	return ret;
+}
@@ -0,0 +1,132 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "uniio.h"
+#include "uniscanner.h"
+
+
+static const char *const DEFAULT_PATH = "bench-scanner.txt";
+static const size_t DEFAULT_SIZE = 8;
+
+static const char *const SAMPLE = "\tint переменная_1 = 42; // комментарий\n";
+
+
+typedef char32_t (*scanner)(universal_io *const io);
+
+
+/** Character scanning through format string, as done before specialised readers */
+static char32_t scan_by_format(universal_io *const io)
+{
+	char buffer[MAX_SYMBOL_SIZE];
+	if (!uni_scanf(io, "%c", &buffer[0]))
+	{
+		return (char32_t)EOF;
+	}
+
+	const size_t size = utf8_symbol_size(buffer[0]);
+	for (size_t i = 1; i < size; i++)
+	{
+		if (!uni_scanf(io, "%c", &buffer[i]))
+		{
+			return (char32_t)EOF;
+		}
+	}
+
+	return utf8_convert(buffer);
+}
+
+static char *generate(const size_t size)
+{
+	const size_t length = strlen(SAMPLE);
+	char *const text = malloc(size + 1);
+	if (text == NULL)
+	{
+		return NULL;
+	}
+
+	size_t index = 0;
+	while (index + length <= size)
+	{
+		memcpy(&text[index], SAMPLE, length);
+		index += length;
+	}
+
+	text[index] = '\0';
+	return text;
+}
+
+static void measure(const char *const name, universal_io *const io, const scanner func, const size_t size)
+{
+	const clock_t begin = clock();
+
+	size_t characters = 0;
+	char32_t checksum = 0;
+	for (char32_t character = func(io); character != (char32_t)EOF; character = func(io))
+	{
+		checksum = checksum * 31 + character;
+		characters++;
+	}
+
+	const double seconds = (double)(clock() - begin) / CLOCKS_PER_SEC;
+	printf("%-8s %12zu chars  %08x  %10.2f MB/s\n", name, characters, (unsigned)checksum
+		, seconds > 0 ? (double)size / (1024 * 1024) / seconds : 0.0);
+
+	in_clear(io);
+}
+
+
+int main(int argc, const char *argv[])
+{
+	const size_t megabytes = argc > 1 ? (size_t)atoi(argv[1]) : DEFAULT_SIZE;
+	char *const text = generate(megabytes * 1024 * 1024);
+	if (text == NULL)
+	{
+		fprintf(stderr, "cannot allocate %zu MB\n", megabytes);
+		return 1;
+	}
+
+	const size_t size = strlen(text);
+	FILE *const file = fopen(DEFAULT_PATH, "wb");
+	if (file == NULL || fwrite(text, 1, size, file) != size)
+	{
+		fprintf(stderr, "cannot write %s\n", DEFAULT_PATH);
+		free(text);
+		return 1;
+	}
+	fclose(file);
+
+	universal_io io = io_create();
+
+	in_set_buffer(&io, text);
+	measure("buffer", &io, &in_next_char, size);
+
+	in_set_mmap(&io, DEFAULT_PATH);
+	measure("mmap", &io, &in_next_char, size);
+
+	in_set_file(&io, DEFAULT_PATH);
+	measure("file", &io, &in_next_char, size);
+
+	in_set_file(&io, DEFAULT_PATH);
+	measure("format", &io, &scan_by_format, size);
+
+	io_erase(&io);
+	remove(DEFAULT_PATH);
+	free(text);
+	return 0;
+}
@@ -122,7 +122,7 @@ node expression_boolean_literal(node *const context, const item_t type, const bo
 
 	node_add_arg(&nd, type);						// Тип значения выражения
 	node_add_arg(&nd, RVALUE);						// Категория значения выражения
-	node_add_arg(&nd, value ? 1 : 0);				// Значение литерала
+	node_add_arg_int64(&nd, value ? 1 : 0);			// Значение литерала
 	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция выражения
 	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция выражения
 
@@ -132,7 +132,7 @@ node expression_boolean_literal(node *const context, const item_t type, const bo
 bool expression_literal_get_boolean(const node *const nd)
 {
 	assert(node_get_type(nd) == OP_LITERAL);
-	return node_get_arg(nd, 2) != 0;
+	return node_get_arg_int64(nd, 2) != 0;
 }
 
 
@@ -142,7 +142,7 @@ node expression_character_literal(node *const context, const item_t type, const
 
 	node_add_arg(&nd, type);						// Тип значения выражения
 	node_add_arg(&nd, RVALUE);						// Категория значения выражения
-	node_add_arg(&nd, (item_t)value);				// Значение литерала
+	node_add_arg_int64(&nd, (int64_t)value);		// Значение литерала
 	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция выражения
 	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция выражения
 
@@ -152,7 +152,7 @@ node expression_character_literal(node *const context, const item_t type, const
 char32_t expression_literal_get_character(const node *const nd)
 {
 	assert(node_get_type(nd) == OP_LITERAL);
-	return (char32_t)node_get_arg(nd, 2);
+	return (char32_t)node_get_arg_int64(nd, 2);
 }
 
 
@@ -162,7 +162,7 @@ node expression_integer_literal(node *const context, const item_t type, const it
 
 	node_add_arg(&nd, type);						// Тип значения выражения
 	node_add_arg(&nd, RVALUE);						// Категория значения выражения
-	node_add_arg(&nd, value);						// Значение литерала
+	node_add_arg_int64(&nd, value);					// Значение литерала
 	node_add_arg(&nd, (item_t)loc.begin);			// Начальная позиция выражения
 	node_add_arg(&nd, (item_t)loc.end);				// Конечная позиция выражения
 
@@ -172,7 +172,7 @@ node expression_integer_literal(node *const context, const item_t type, const it
 item_t expression_literal_get_integer(const node *const nd)
 {
 	assert(node_get_type(nd) == OP_LITERAL);
-	return node_get_arg(nd, 2);
+	return (item_t)node_get_arg_int64(nd, 2);
 }
 
 
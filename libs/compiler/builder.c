@@ -733,23 +733,20 @@ node build_member_expression(builder *const bldr, node *const base, const size_t
 		category = LVALUE;
 	}
 
-	const size_t member_amount = type_structure_get_member_amount(bldr->sx, struct_type);
-	for (size_t i = 0; i < member_amount; i++)
+	const size_t member_index = type_structure_get_member_index(bldr->sx, struct_type, name);
+	if (member_index == SIZE_MAX)
 	{
-		if (name == type_structure_get_member_name(bldr->sx, struct_type, i))
-		{
-			const item_t member_type = type_structure_get_member_type(bldr->sx, struct_type, i);
-			const item_t type = type_is_const(bldr->sx, struct_type) && !type_is_const(bldr->sx, member_type)
-				? type_const(bldr->sx, member_type)
-				: type_structure_get_member_type(bldr->sx, struct_type, i);
-			const location loc = { node_get_location(base).begin, id_loc.end };
-
-			return expression_member(type, category, i, is_arrow, base, loc);
-		}
+		semantic_error(bldr, id_loc, no_such_member, repr_get_name(bldr->sx, name));
+		return node_broken();
 	}
 
-	semantic_error(bldr, id_loc, no_such_member, repr_get_name(bldr->sx, name));
-	return node_broken();
+	const item_t member_type = type_structure_get_member_type(bldr->sx, struct_type, member_index);
+	const item_t type = type_is_const(bldr->sx, struct_type) && !type_is_const(bldr->sx, member_type)
+		? type_const(bldr->sx, member_type)
+		: member_type;
+	const location loc = { node_get_location(base).begin, id_loc.end };
+
+	return expression_member(type, category, member_index, is_arrow, base, loc);
 }
 
 node build_cast_expression(const item_t target_type, node *const expr)
@@ -768,13 +765,13 @@ node build_cast_expression(const item_t target_type, node *const expr)
 		{
 			// Пока тут только int -> float
 			const item_t value = expression_literal_get_integer(expr);
-			const node result = node_insert(expr, OP_LITERAL, DOUBLE_SIZE + 4);
+			const node result = node_insert(expr, OP_LITERAL, 5);
 
 			node_set_arg(&result, 0, TYPE_FLOATING);
 			node_set_arg(&result, 1, RVALUE);
 			node_set_arg_double(&result, 2, (double)value);
-			node_set_arg(&result, DOUBLE_SIZE + 2, (item_t)loc.begin);
-			node_set_arg(&result, DOUBLE_SIZE + 3, (item_t)loc.end);
+			node_set_arg(&result, 3, (item_t)loc.begin);
+			node_set_arg(&result, 4, (item_t)loc.end);
 
 			node_remove(expr);
 			return result;
@@ -19,6 +19,7 @@
 #include "errors.h"
 #include "instructions.h"
 #include "item.h"
+#include "layout.h"
 #include "string.h"
 #include "tree.h"
 #include "uniprinter.h"
@@ -62,6 +63,7 @@ typedef struct lvalue
 typedef struct encoder
 {
 	syntax *const sx;				/**< Syntax structure */
+	arena *region;					/**< Memory region of encoder tables */
 
 	vector memory;					/**< Memory table */
 	vector iniprocs;				/**< Init procedures */
@@ -69,8 +71,11 @@ typedef struct encoder
 	vector identifiers;				/**< Local identifiers table */
 	vector representations;			/**< Local representations table */
 	vector displacements;			/**< Displacements table */
+	vector compressed;				/**< Identifiers in local identifiers table, @c ITEM_MAX if absent */
 	vector functions;				/**< Functions table */
 
+	const layout *layout;			/**< Type layout of virtual machine */
+
 	size_t addr_cond;				/**< Condition address */
 	size_t addr_case;				/**< Case operator address */
 	size_t addr_break;				/**< Break operator address */
@@ -165,7 +170,7 @@ static inline item_t proc_get(const encoder *const enc, const size_t index)
 static inline item_t displacements_add(encoder *const enc, const size_t identifier)
 {
 	const item_t type = ident_get_type(enc->sx, identifier);
-	const item_t size = (item_t)type_size(enc->sx, type);
+	const item_t size = (item_t)layout_get_size(enc->layout, type);
 	item_t result_displ = enc->displ;
 
 	if (enc->curr_func)
@@ -300,27 +305,37 @@ static void addr_end_break(encoder *const enc)
  *
  *	@param	ws			Compiler workspace
  *	@param	sx			Syntax structure
+ *	@param	lt			Type layout
  *
  *	@return	Encoder
  */
-static encoder enc_create(const workspace *const ws, syntax *const sx)
+static encoder enc_create(const workspace *const ws, syntax *const sx, const layout *const lt)
 {
-	encoder enc = { .sx = sx, .target = item_get_status(ws) };
+	encoder enc = { .sx = sx, .layout = lt, .target = item_get_status(ws) };
+
+	enc.region = arena_create(0);
 
-	enc.memory = vector_create(MAX_MEM_SIZE);
-	enc.iniprocs = vector_create(0);
+	enc.memory = vector_create_in(enc.region, MAX_MEM_SIZE);
+	enc.iniprocs = vector_create_in(enc.region, 0);
 
-	const size_t records = vector_size(&sx->identifiers) / 4;
-	enc.identifiers = vector_create(records * 3);
-	enc.representations = vector_create(records * 8);
-	enc.displacements = vector_create(records);
-	enc.functions = vector_create(records);
+	const size_t records = ident_get_amount(sx);
+	enc.identifiers = vector_create_in(enc.region, records * 3);
+	enc.representations = vector_create_in(enc.region, records * 8);
+	enc.displacements = vector_create_in(enc.region, records);
+	enc.compressed = vector_create_in(enc.region, records);
+	enc.functions = vector_create_in(enc.region, records);
 
 	vector_increase(&enc.memory, 4);
 	vector_increase(&enc.iniprocs, vector_size(&enc.sx->types));
-	vector_increase(&enc.displacements, vector_size(&sx->identifiers));
+	vector_increase(&enc.displacements, records);
+	vector_increase(&enc.compressed, records);
+	for (size_t i = 0; i < records; i++)
+	{
+		vector_set(&enc.compressed, i, ITEM_MAX);
+	}
 	vector_increase(&enc.functions, 2);
 
+
 	enc.max_global_displ = 3;
 	enc.curr_func = NULL;
 
@@ -347,10 +362,11 @@ static int print_table(const encoder *const enc, const vector *const table)
 			return -1;
 		}
 
-		uni_printf(enc->sx->io, "%" PRIitem " ", item);
+		uni_print_item(enc->sx->io, item);
+		uni_print_char(enc->sx->io, ' ');
 	}
 
-	uni_printf(enc->sx->io, "\n");
+	uni_print_char(enc->sx->io, '\n');
 	return 0;
 }
 
@@ -387,12 +403,20 @@ static int enc_export(const encoder *const enc)
  */
 static void enc_clear(encoder *const enc)
 {
+	// Блоки региона освобождаются вместе с ним, а без региона - по отдельности
 	vector_clear(&enc->memory);
 	vector_clear(&enc->iniprocs);
 	vector_clear(&enc->identifiers);
 	vector_clear(&enc->representations);
 	vector_clear(&enc->displacements);
+	vector_clear(&enc->compressed);
 	vector_clear(&enc->functions);
+
+	if (enc->region != NULL)
+	{
+		arena_clear(enc->region);
+		enc->region = NULL;
+	}
 }
 
 /**
@@ -436,7 +460,7 @@ static void emit_load_of_lvalue(encoder *const enc, lvalue value)
 			{
 				mem_add(enc, IC_COPY0ST);
 				mem_add(enc, value.displ);
-				mem_add(enc, (item_t)type_size(enc->sx, value.type));
+				mem_add(enc, (item_t)layout_get_size(enc->layout, value.type));
 			}
 			else
 			{
@@ -452,7 +476,7 @@ static void emit_load_of_lvalue(encoder *const enc, lvalue value)
 			if (type_is_structure(enc->sx, value.type))
 			{
 				mem_add(enc, IC_COPY1ST);
-				mem_add(enc, (item_t)type_size(enc->sx, value.type));
+				mem_add(enc, (item_t)layout_get_size(enc->layout, value.type));
 			}
 			else if (!type_is_array(enc->sx, value.type) && !type_is_pointer(enc->sx, value.type))
 			{
@@ -501,7 +525,7 @@ static lvalue emit_subscript_lvalue(encoder *const enc, const node *const nd)
 	mem_add(enc, IC_SLICE);
 
 	const item_t type = expression_get_type(nd);
-	mem_add(enc, (item_t)type_size(enc->sx, type));
+	mem_add(enc, (item_t)layout_get_size(enc->layout, type));
 	if (type_is_array(enc->sx, type))
 	{
 		mem_add(enc, IC_LAT);
@@ -527,12 +551,7 @@ static lvalue emit_member_lvalue(encoder *const enc, const node *const nd)
 	const size_t member_index = expression_member_get_member_index(nd);
 	const item_t struct_type = is_arrow ? type_pointer_get_element_type(enc->sx, base_type) : base_type;
 
-	item_t member_displ = 0;
-	for (size_t i = 0; i < member_index; i++)
-	{
-		const item_t member_type = type_structure_get_member_type(enc->sx, struct_type, i);
-		member_displ += (item_t)type_size(enc->sx, member_type);
-	}
+	const item_t member_displ = (item_t)layout_get_member_offset(enc->layout, struct_type, member_index);
 
 	if (is_arrow)
 	{
@@ -776,9 +795,10 @@ static void emit_argument(encoder *const enc, const node *const nd)
 
 static void compress_ident(encoder *const enc, const size_t ref)
 {
-	if (vector_get(&enc->sx->identifiers, ref) == ITEM_MAX)
+	const item_t compressed = vector_get(&enc->compressed, ref);
+	if (compressed != ITEM_MAX)
 	{
-		mem_add(enc, ident_get_repr(enc->sx, ref));
+		mem_add(enc, compressed);
 		return;
 	}
 
@@ -796,8 +816,7 @@ static void compress_ident(encoder *const enc, const size_t ref)
 	}
 	vector_add(&enc->representations, '\0');
 
-	vector_set(&enc->sx->identifiers, ref, ITEM_MAX);
-	ident_set_repr(enc->sx, ref, new_ref);
+	vector_set(&enc->compressed, ref, new_ref);
 	mem_add(enc, new_ref);
 }
 
@@ -809,12 +828,10 @@ static void compress_ident(encoder *const enc, const size_t ref)
  */
 static void emit_printid_expression(encoder *const enc, const node *const nd)
 {
-	const size_t argc = expression_call_get_arguments_amount(nd);
-	for (size_t i = 0; i < argc; i++)
+	for (node arg = expression_call_get_argument(nd, 0); node_is_correct(&arg); arg = node_get_sibling(&arg))
 	{
 		mem_add(enc, IC_PRINTID);
 
-		const node arg = expression_call_get_argument(nd, i);
 		compress_ident(enc, expression_identifier_get_id(&arg)); // Ссылка в identtab
 	}
 }
@@ -827,12 +844,10 @@ static void emit_printid_expression(encoder *const enc, const node *const nd)
  */
 static void emit_getid_expression(encoder *const enc, const node *const nd)
 {
-	const size_t argc = expression_call_get_arguments_amount(nd);
-	for (size_t i = 0; i < argc; i++)
+	for (node arg = expression_call_get_argument(nd, 0); node_is_correct(&arg); arg = node_get_sibling(&arg))
 	{
 		mem_add(enc, IC_GETID);
 
-		const node arg = expression_call_get_argument(nd, i);
 		compress_ident(enc, expression_identifier_get_id(&arg)); // Ссылка в identtab
 	}
 }
@@ -846,13 +861,11 @@ static void emit_getid_expression(encoder *const enc, const node *const nd)
 static void emit_printf_expression(encoder *const enc, const node *const nd)
 {
 	size_t sum_size = 0;
-	const size_t argc = expression_call_get_arguments_amount(nd);
-	for (size_t i = 1; i < argc; i++)
+	for (node arg = expression_call_get_argument(nd, 1); node_is_correct(&arg); arg = node_get_sibling(&arg))
 	{
-		const node arg = expression_call_get_argument(nd, i);
 		emit_expression(enc, &arg);
 
-		sum_size += type_size(enc->sx, expression_get_type(&arg));
+		sum_size += layout_get_size(enc->layout, expression_get_type(&arg));
 	}
 
 	const node format_string = expression_call_get_argument(nd, 0);
@@ -870,10 +883,8 @@ static void emit_printf_expression(encoder *const enc, const node *const nd)
  */
 static void emit_print_expression(encoder *const enc, const node *const nd)
 {
-	const size_t argc = expression_call_get_arguments_amount(nd);
-	for (size_t i = 0; i < argc; i++)
+	for (node arg = expression_call_get_argument(nd, 0); node_is_correct(&arg); arg = node_get_sibling(&arg))
 	{
-		const node arg = expression_call_get_argument(nd, i);
 		emit_expression(enc, &arg);
 
 		mem_add(enc, IC_PRINT);
@@ -915,10 +926,8 @@ static void emit_call_expression(encoder *const enc, const node *const nd)
 		mem_add(enc, IC_CALL1);
 	}
 
-	const size_t args = expression_call_get_arguments_amount(nd);
-	for (size_t i = 0; i < args; i++)
+	for (node argument = expression_call_get_argument(nd, 0); node_is_correct(&argument); argument = node_get_sibling(&argument))
 	{
-		const node argument = expression_call_get_argument(nd, i);
 		emit_argument(enc, &argument);
 	}
 
@@ -948,17 +957,12 @@ static void emit_member_expression(encoder *const enc, const node *const nd)
 	const item_t base_type = expression_get_type(&base);
 	const size_t member_index = expression_member_get_member_index(nd);
 
-	size_t member_displ = 0;
-	for (size_t i = 0; i < member_index; i++)
-	{
-		const item_t member_type = type_structure_get_member_type(enc->sx, base_type, i);
-		member_displ += type_size(enc->sx, member_type);
-	}
+	const size_t member_displ = layout_get_member_offset(enc->layout, base_type, member_index);
 
 	mem_add(enc, IC_COPYST);
 	mem_add(enc, (item_t)member_displ);
-	mem_add(enc, (item_t)type_size(enc->sx, expression_get_type(nd)));
-	mem_add(enc, (item_t)type_size(enc->sx, base_type));
+	mem_add(enc, (item_t)layout_get_size(enc->layout, expression_get_type(nd)));
+	mem_add(enc, (item_t)layout_get_size(enc->layout, base_type));
 }
 
 /**
@@ -1186,7 +1190,7 @@ static void emit_assignment_expression(encoder *const enc, const node *const nd)
 			mem_add(enc, IC_COPY1ST_ASSIGN);
 		}
 
-		mem_add(enc, (item_t)type_size(enc->sx, type));
+		mem_add(enc, (item_t)layout_get_size(enc->layout, type));
 	}
 	else // Скалярное присваивание
 	{
@@ -1404,7 +1408,7 @@ static void emit_array_declaration(encoder *const enc, const node *const nd)
 	}
 
 	const bool has_initializer = declaration_variable_has_initializer(nd);
-	const item_t length = (item_t)type_size(enc->sx, type);
+	const item_t length = (item_t)layout_get_size(enc->layout, type);
 	const item_t displ = displacements_add(enc, identifier);
 	const item_t iniproc = proc_get(enc, (size_t)type);
 
@@ -1475,7 +1479,7 @@ static void emit_variable_declaration(encoder *const enc, const node *const nd)
 		{
 			mem_add(enc, IC_COPY0ST_ASSIGN);
 			mem_add(enc, displ);
-			mem_add(enc, (item_t)type_size(enc->sx, unqualified_type));
+			mem_add(enc, (item_t)layout_get_size(enc->layout, unqualified_type));
 		}
 		else
 		{
@@ -1512,7 +1516,7 @@ static void emit_member_declaration(encoder *const enc, const node *const nd, co
 		emit_expression(enc, &bound);
 	}
 
-	const size_t length = type_size(enc->sx, member_type);
+	const size_t length = layout_get_size(enc->layout, member_type);
 	const item_t iniproc = proc_get(enc, (size_t)member_type);
 
 	mem_add(enc, IC_DEFARR); 		// DEFARR N, d, displ, iniproc, usual N1...NN, уже лежат на стеке
@@ -1564,7 +1568,7 @@ static void emit_struct_declaration(encoder *const enc, const node *const nd)
 		if (declaration_get_class(&member) == DECL_MEMBER)
 		{
 			emit_member_declaration(enc, &member, displ);
-			displ += type_size(enc->sx, declaration_member_get_type(&member));
+			displ += layout_get_size(enc->layout, declaration_member_get_type(&member));
 		}
 		else
 		{
@@ -1658,10 +1662,8 @@ static void emit_declaration(encoder *const enc, const node *const nd)
  */
 static void emit_declaration_statement(encoder *const enc, const node *const nd)
 {
-	const size_t size = statement_declaration_get_size(nd);
-	for (size_t i = 0; i < size; i++)
+	for (node decl = statement_declaration_get_declarator(nd, 0); node_is_correct(&decl); decl = node_get_sibling(&decl))
 	{
-		const node decl = statement_declaration_get_declarator(nd, i);
 		emit_declaration(enc, &decl);
 	}
 }
@@ -1719,11 +1721,9 @@ static void emit_default_statement(encoder *const enc, const node *const nd)
 static void emit_compound_statement(encoder *const enc, const node *const nd)
 {
 	const item_t scope_displacement = enc->displ;
-	const size_t size = statement_compound_get_size(nd);
 
-	for (size_t i = 0; i < size; i++)
+	for (node substmt = statement_compound_get_substmt(nd, 0); node_is_correct(&substmt); substmt = node_get_sibling(&substmt))
 	{
-		const node substmt = statement_compound_get_substmt(nd, i);
 		emit_statement(enc, &substmt);
 	}
 
@@ -1942,7 +1942,7 @@ static void emit_return_statement(encoder *const enc, const node *const nd)
 		emit_expression(enc, &expr);
 
 		mem_add(enc, IC_RETURN_VAL);
-		mem_add(enc, (item_t)type_size(enc->sx, type));
+		mem_add(enc, (item_t)layout_get_size(enc->layout, type));
 	}
 	else
 	{
@@ -2025,10 +2025,8 @@ static void emit_statement(encoder *const enc, const node *const nd)
  */
 static void emit_translation_unit(encoder *const enc, const node *const nd)
 {
-	const size_t size = translation_unit_get_size(nd);
-	for (size_t i = 0; i < size; i++)
+	for (node decl = translation_unit_get_declaration(nd, 0); node_is_correct(&decl); decl = node_get_sibling(&decl))
 	{
-		const node decl = translation_unit_get_declaration(nd, i);
 		emit_declaration(enc, &decl);
 	}
 
@@ -2050,14 +2048,14 @@ static void emit_translation_unit(encoder *const enc, const node *const nd)
  */
 
 
-int encode_to_vm(const workspace *const ws, syntax *const sx)
+int encode_to_vm(const workspace *const ws, syntax *const sx, const layout *const lt)
 {
-	if (!ws_is_correct(ws) || sx == NULL)
+	if (!ws_is_correct(ws) || sx == NULL || lt == NULL)
 	{
 		return -1;
 	}
 
-	encoder enc = enc_create(ws, sx);
+	encoder enc = enc_create(ws, sx, lt);
 
 	const node root = node_get_root(&sx->tree);
 	emit_translation_unit(&enc, &root);
@@ -24,10 +24,13 @@
 #include "llvmgen.h"
 #include "parser.h"
 #include "macro.h"
+#include "simd.h"
+#include "stream.h"
 #include "syntax.h"
 #include "uniio.h"
 
 #ifndef _WIN32
+	#include <pthread.h>
 	#include <sys/stat.h>
 	#include <sys/types.h>
 #endif
@@ -40,8 +43,35 @@ static const char *const DEFAULT_LLVM = "out.ll";
 static const char *const DEFAULT_MIPS = "out.s";
 static const char *const DEFAULT_RISCV = "out-riscv.s";
 
+static const size_t STREAM_CHUNK_SIZE = 16384;
+static const size_t STREAM_CHUNKS = 64;
 
-typedef int (*encoder)(const workspace *const ws, syntax *const sx);
+
+typedef int (*encoder)(const workspace *const ws, syntax *const sx, const layout *const lt);
+
+/** Target of code generation */
+typedef struct target
+{
+	encoder enc;				/**< Encoding function */
+	size_t word_size;			/**< Size of non-floating scalar types, @c 0 if layout is not used */
+	size_t floating_size;		/**< Size of floating types */
+} target;
+
+static const target TARGET_VM = { &encode_to_vm, VM_WORD_SIZE, VM_FLOATING_SIZE };
+static const target TARGET_LLVM = { &encode_to_llvm, 0, 0 };
+static const target TARGET_MIPS = { &encode_to_mips, MIPS_WORD_SIZE, MIPS_FLOATING_SIZE };
+static const target TARGET_RISCV = { &encode_to_riscv, RISCV_WORD_SIZE, RISCV_FLOATING_SIZE };
+
+/** Macro processing on worker thread */
+typedef struct macro_worker
+{
+	workspace *ws;				/**< Workspace */
+	stream *strm;				/**< Stream of preprocessed text */
+#ifndef _WIN32
+	pthread_t thread;			/**< Worker thread */
+#endif
+	int ret;					/**< Result of macro processing */
+} macro_worker;
 
 
 /** Make executable actually executable on best-effort basis (if possible) */
@@ -62,11 +92,68 @@ static inline void make_executable(const char *const path)
 }
 
 
-static status_t compile_from_io(const workspace *const ws, universal_io *const io, const encoder enc)
+#ifndef _WIN32
+static void *worker_run(void *const arg)
 {
-	if (!in_is_correct(io) || !out_is_correct(io))
+	macro_worker *const worker = arg;
+	worker->ret = macro_to_stream(worker->ws, worker->strm);
+	return NULL;
+}
+#endif
+
+/** Start macro processing on worker thread, @c -1 if threads are not available */
+static int worker_start(macro_worker *const worker, workspace *const ws)
+{
+#ifndef _WIN32
+	worker->ws = ws;
+	worker->ret = 0;
+	worker->strm = stream_create(STREAM_CHUNK_SIZE, STREAM_CHUNKS);
+	if (worker->strm == NULL)
+	{
+		return -1;
+	}
+
+	// Определение набора инструкций не защищено от гонки, выполняем его до запуска потока
+	simd_get_level();
+
+	if (pthread_create(&worker->thread, NULL, &worker_run, worker) != 0)
+	{
+		stream_free(worker->strm);
+		return -1;
+	}
+
+	return 0;
+#else
+	(void)worker;
+	(void)ws;
+	return -1;
+#endif
+}
+
+/** Wait for the end of macro processing, the rest of stream is discarded */
+static int worker_join(macro_worker *const worker)
+{
+	if (worker == NULL)
+	{
+		return 0;
+	}
+
+#ifndef _WIN32
+	stream_cancel(worker->strm);
+	pthread_join(worker->thread, NULL);
+#endif
+	return worker->ret;
+}
+
+
+static status_t compile_from_io(const workspace *const ws, universal_io *const io, const target *const tgt
+	, macro_worker *const worker)
+{
+	// Вывод при потоковом препроцессинге открывается только после его завершения
+	if (!in_is_correct(io) || (worker == NULL && !out_is_correct(io)))
 	{
 		error_msg("некорректные параметры ввода/вывода");
+		worker_join(worker);
 		io_erase(io);
 		return sts_system_error;
 	}
@@ -75,16 +162,37 @@ static status_t compile_from_io(const workspace *const ws, universal_io *const i
 	int ret = parse(&sx);
 	status_t sts = sts_parse_error;
 
+	// Макрогенерация должна завершиться до связывания и генерации кода
+	if (worker_join(worker))
+	{
+		ret = -1;
+		sts = sts_macro_error;
+	}
+	else if (worker != NULL && out_set_file(io, ws_get_output(ws)))
+	{
+		error_msg("некорректные параметры ввода/вывода");
+		ret = -1;
+		sts = sts_system_error;
+	}
+
 	if (!ret && !ws_has_flag(ws, "-c")) // Skip linker stage
 	{
 		ret = !sx_is_correct(&sx);
 		sts = sts_link_error;
 	}
 
-	if (!ret)
+	if (!ret && tgt->word_size == 0)
+	{
+		ret = tgt->enc(ws, &sx, NULL);
+		sts = sts_codegen_error;
+	}
+	else if (!ret)
 	{
-		ret = enc(ws, &sx);
+		// Размеры и смещения типов вычисляются один раз для всей генерации кода
+		layout lt = layout_create(&sx, tgt->word_size, tgt->floating_size);
+		ret = tgt->enc(ws, &sx, &lt);
 		sts = sts_codegen_error;
+		layout_clear(&lt);
 	}
 
 	sx_clear(&sx);
@@ -92,7 +200,7 @@ static status_t compile_from_io(const workspace *const ws, universal_io *const i
 	return ret ? sts : sts_success;
 }
 
-static status_t compile_from_ws(workspace *const ws, const encoder enc)
+static status_t compile_from_ws(workspace *const ws, const target *const tgt)
 {
 	if (!ws_is_correct(ws) || ws_get_files_num(ws) == 0)
 	{
@@ -106,16 +214,28 @@ static status_t compile_from_ws(workspace *const ws, const encoder enc)
 	}
 
 	universal_io io = io_create();
+	macro_worker worker;
+	macro_worker *current_worker = NULL;
 
 #ifndef GENERATE_MACRO
-	// Препроцессинг в массив
-	char *const preprocessing = macro(ws); // макрогенерация
-	if (preprocessing == NULL)
+	char *preprocessing = NULL;
+	if (ws_has_flag(ws, "-stream") && !worker_start(&worker, ws))
 	{
-		return sts_macro_error;
+		// Препроцессинг в отдельном потоке, лексер получает текст по частям
+		current_worker = &worker;
+		in_set_stream(&io, worker.strm);
+	}
+	else
+	{
+		// Препроцессинг в массив
+		preprocessing = macro(ws); // макрогенерация
+		if (preprocessing == NULL)
+		{
+			return sts_macro_error;
+		}
+
+		in_set_buffer(&io, preprocessing);
 	}
-
-	in_set_buffer(&io, preprocessing);
 #else
 	int ret_macro = macro_to_file(ws, DEFAULT_MACRO);
 	if (ret_macro)
@@ -123,15 +243,31 @@ static status_t compile_from_ws(workspace *const ws, const encoder enc)
 		return sts_macro_error;
 	}
 
-	in_set_file(&io, DEFAULT_MACRO);
+	if (ws_has_flag(ws, "-mmap"))
+	{
+		in_set_mmap(&io, DEFAULT_MACRO);
+	}
+	else
+	{
+		in_set_file(&io, DEFAULT_MACRO);
+	}
 #endif
 
-	out_set_file(&io, ws_get_output(ws));
-	const status_t sts = compile_from_io(ws, &io, enc);
+	if (current_worker == NULL)
+	{
+		out_set_file(&io, ws_get_output(ws));
+	}
+
+	const status_t sts = compile_from_io(ws, &io, tgt, current_worker);
 
 #ifndef GENERATE_MACRO
 	free(preprocessing);
 #endif
+	if (current_worker != NULL)
+	{
+		stream_free(current_worker->strm);
+	}
+
 	return sts;
 }
 
@@ -172,7 +308,7 @@ status_t compile_to_vm(workspace *const ws)
 		ws_set_output(ws, DEFAULT_VM);
 	}
 
-	const status_t sts = compile_from_ws(ws, &encode_to_vm);
+	const status_t sts = compile_from_ws(ws, &TARGET_VM);
 	if (sts == sts_success)
 	{
 		make_executable(ws_get_output(ws));
@@ -188,7 +324,7 @@ status_t compile_to_llvm(workspace *const ws)
 		ws_set_output(ws, DEFAULT_LLVM);
 	}
 
-	const status_t sts = compile_from_ws(ws, &encode_to_llvm);
+	const status_t sts = compile_from_ws(ws, &TARGET_LLVM);
 	return sts == sts_codegen_error ? sts_llvm_error : sts;
 }
 
@@ -199,7 +335,7 @@ int compile_to_mips(workspace *const ws)
 		ws_set_output(ws, DEFAULT_MIPS);
 	}
 
-	return compile_from_ws(ws, &encode_to_mips);
+	return compile_from_ws(ws, &TARGET_MIPS);
 }
 
 int compile_to_riscv(workspace *const ws)
@@ -209,7 +345,7 @@ int compile_to_riscv(workspace *const ws)
 		ws_set_output(ws, DEFAULT_RISCV);
 	}
 
-	return compile_from_ws(ws, &encode_to_riscv);
+	return compile_from_ws(ws, &TARGET_RISCV);
 }
 
 
@@ -267,7 +403,7 @@ int no_macro_compile_to_vm(const char *const path)
 	ws_set_output(&ws, DEFAULT_VM);
 	out_set_file(&io, ws_get_output(&ws));
 
-	const int ret = compile_from_io(&ws, &io, &encode_to_vm);
+	const int ret = compile_from_io(&ws, &io, &TARGET_VM, NULL);
 	if (!ret)
 	{
 		make_executable(ws_get_output(&ws));
@@ -287,7 +423,7 @@ int no_macro_compile_to_llvm(const char *const path)
 	ws_set_output(&ws, DEFAULT_LLVM);
 	out_set_file(&io, ws_get_output(&ws));
 
-	const int ret = compile_from_io(&ws, &io, &encode_to_llvm);
+	const int ret = compile_from_io(&ws, &io, &TARGET_LLVM, NULL);
 	ws_clear(&ws);
 	return ret;
 }
@@ -302,7 +438,7 @@ int no_macro_compile_to_mips(const char *const path)
 	ws_set_output(&ws, DEFAULT_MIPS);
 	out_set_file(&io, ws_get_output(&ws));
 
-	const int ret = compile_from_io(&ws, &io, &encode_to_mips);
+	const int ret = compile_from_io(&ws, &io, &TARGET_MIPS, NULL);
 	ws_clear(&ws);
 	return ret;
 }
@@ -317,7 +453,7 @@ int no_macro_compile_to_risv(const char *const path)
 	ws_set_output(&ws, DEFAULT_MIPS);
 	out_set_file(&io, ws_get_output(&ws));
 
-	const int ret = compile_from_io(&ws, &io, &encode_to_mips);
+	const int ret = compile_from_io(&ws, &io, &TARGET_MIPS, NULL);
 	ws_clear(&ws);
 	return ret;
 }
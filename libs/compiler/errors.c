@@ -62,6 +62,9 @@ static void get_error(const err_t num, char *const msg, va_list args)
 		case unterminated_block_comment:
 			sprintf(msg, "блочный комментарий не окончен");
 			break;
+		case spelling_out_of_memory:
+			sprintf(msg, "недостаточно памяти для записи лексемы");
+			break;
 
 		// Syntax errors
 		case extraneous_bracket_before_semi:
@@ -479,6 +482,12 @@ static void get_warning(const warning_t num, char *const msg, va_list args)
 static void output(universal_io *const io, const char *const msg
 	, const logger system_func, void (*func)(location *const, const char *const))
 {
+	// Текст из потока может быть неполным, по нему сообщается только после успешного препроцессинга
+	if (in_is_stream(io) && in_receive_rest(io))
+	{
+		return;
+	}
+
 	location loc = loc_search(io);
 
 	if (!loc_is_correct(&loc))
@@ -35,6 +35,7 @@ typedef enum ERROR
 	missing_terminating_apost_char,			/**< Missing terminating ' character */
 	missing_terminating_quote_char,			/**< Missing terminating " character */
 	unterminated_block_comment,				/**< Unterminated block comment */
+	spelling_out_of_memory,					/**< No memory for token spelling */
 
 	// Syntax errors
 	extraneous_bracket_before_semi,			/**< Extraneous bracket before ';' */
@@ -0,0 +1,37 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include "keywords.h"
+#include <string.h>
+#include "operations.h"
+#include "keywords_table.h"
+
+
+extern uint32_t keyword_hash(const char *const spelling, const size_t length, const uint32_t seed);
+
+
+const keyword *keyword_find(const char *const spelling, const size_t length)
+{
+	if (spelling == NULL || length > KEYWORDS_MAX_LENGTH)
+	{
+		return NULL;
+	}
+
+	const uint32_t seed = keywords_seeds[keyword_hash(spelling, length, 0) % KEYWORDS_BUCKETS];
+	const keyword *const kw = &keywords_table[keyword_hash(spelling, length, seed) % KEYWORDS_SIZE];
+
+	return kw->length == length && memcmp(kw->spelling, spelling, length) == 0 ? kw : NULL;
+}
@@ -0,0 +1,74 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "item.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Keyword or builtin function spelling */
+typedef struct keyword
+{
+	const char *spelling;		/**< Spelling in UTF-8 */
+	size_t length;				/**< Spelling length in bytes */
+	item_t reference;			/**< Keyword token or builtin function identifier */
+} keyword;
+
+
+/**
+ *	Find keyword or builtin function in the table generated at build time
+ *
+ *	@param	spelling	Spelling in UTF-8
+ *	@param	length		Spelling length in bytes
+ *
+ *	@return	Keyword or builtin function, @c NULL if not found
+ */
+const keyword *keyword_find(const char *const spelling, const size_t length);
+
+
+/**
+ *	Hash of spelling used by keywords perfect hash table
+ *
+ *	@param	spelling	Spelling in UTF-8
+ *	@param	length		Spelling length in bytes
+ *	@param	seed		Hash seed
+ *
+ *	@return	Hash value
+ */
+inline uint32_t keyword_hash(const char *const spelling, const size_t length, const uint32_t seed)
+{
+	uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+	for (size_t i = 0; i < length; i++)
+	{
+		hash ^= (uint8_t)spelling[i];
+		hash *= 16777619u;
+	}
+
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6Bu;
+	hash ^= hash >> 13;
+	return hash;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
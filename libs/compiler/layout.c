@@ -0,0 +1,167 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include "layout.h"
+
+
+/*
+ *	Запись структуры в data:
+ *		[size][alignment][offset of member 0]...[offset of member N-1]
+ */
+
+
+static size_t layout_compute(layout *const lt, const item_t type);
+
+/**	Get record of structure type, type must be structure */
+static inline size_t layout_get_record(const layout *const lt, const item_t type)
+{
+	const item_t structure = type_is_const(lt->sx, type) ? type_const_get_unqualified_type(lt->sx, type) : type;
+	return (size_t)vector_at(&lt->records, (size_t)structure);
+}
+
+/**	Get size of type while records are computed */
+static size_t layout_compute_size(layout *const lt, const item_t type)
+{
+	if (type_is_structure(lt->sx, type))
+	{
+		const size_t record = layout_get_record(lt, type);
+		return (size_t)vector_at(&lt->data, record != 0 ? record : layout_compute(lt, type));
+	}
+
+	return layout_get_size(lt, type);
+}
+
+/**	Get alignment of type while records are computed */
+static size_t layout_compute_alignment(layout *const lt, const item_t type)
+{
+	if (type_is_structure(lt->sx, type))
+	{
+		const size_t record = layout_get_record(lt, type);
+		return (size_t)vector_at(&lt->data, (record != 0 ? record : layout_compute(lt, type)) + 1);
+	}
+
+	return layout_get_alignment(lt, type);
+}
+
+/**	Compute record of structure type */
+static size_t layout_compute(layout *const lt, const item_t type)
+{
+	const item_t structure = type_is_const(lt->sx, type) ? type_const_get_unqualified_type(lt->sx, type) : type;
+	const size_t amount = type_structure_get_member_amount(lt->sx, structure);
+	const size_t record = vector_size(&lt->data);
+	vector_increase(&lt->data, 2 + amount);
+
+	size_t size = 0;
+	size_t alignment = 1;
+	for (size_t i = 0; i < amount; i++)
+	{
+		// Вложенные структуры могут добавлять свои записи, поэтому без указателей в data
+		const item_t member_type = type_structure_get_member_type(lt->sx, structure, i);
+		const size_t member_alignment = layout_compute_alignment(lt, member_type);
+
+		vector_set(&lt->data, record + 2 + i, (item_t)size);
+		size += layout_compute_size(lt, member_type);
+		alignment = member_alignment > alignment ? member_alignment : alignment;
+	}
+
+	vector_set(&lt->data, record, (item_t)size);
+	vector_set(&lt->data, record + 1, (item_t)alignment);
+	vector_set(&lt->records, (size_t)structure, (item_t)record);
+
+	return record;
+}
+
+
+/*
+ *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
+ *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
+ *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
+ *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
+ *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+ */
+
+
+layout layout_create(const syntax *const sx, const size_t word_size, const size_t floating_size)
+{
+	layout lt;
+	lt.sx = sx;
+
+	lt.word_size = word_size;
+	lt.floating_size = floating_size;
+
+	const size_t types = vector_size(&sx->types);
+	lt.records = vector_create(types);
+	vector_increase(&lt.records, types);
+
+	// Нулевая запись зарезервирована под отсутствие записи
+	lt.data = vector_create(types);
+	vector_increase(&lt.data, 1);
+
+	// Записи типов связаны в список от последней к первой
+	for (size_t start = sx->start_type; start != 0; start = (size_t)vector_at(&sx->types, start))
+	{
+		const item_t type = (item_t)start + 1;
+		if (type_is_structure(sx, type) && layout_get_record(&lt, type) == 0)
+		{
+			layout_compute(&lt, type);
+		}
+	}
+
+	return lt;
+}
+
+size_t layout_get_size(const layout *const lt, const item_t type)
+{
+	if (type_is_structure(lt->sx, type))
+	{
+		return (size_t)vector_at(&lt->data, layout_get_record(lt, type));
+	}
+
+	return type_is_floating(lt->sx, type) ? lt->floating_size : lt->word_size;
+}
+
+size_t layout_get_alignment(const layout *const lt, const item_t type)
+{
+	if (type_is_structure(lt->sx, type))
+	{
+		return (size_t)vector_at(&lt->data, layout_get_record(lt, type) + 1);
+	}
+
+	return type_is_floating(lt->sx, type) ? lt->floating_size : lt->word_size;
+}
+
+size_t layout_get_member_offset(const layout *const lt, const item_t type, const size_t index)
+{
+	if (!type_is_structure(lt->sx, type) || index >= type_structure_get_member_amount(lt->sx, type))
+	{
+		return SIZE_MAX;
+	}
+
+	return (size_t)vector_at(&lt->data, layout_get_record(lt, type) + 2 + index);
+}
+
+
+int layout_clear(layout *const lt)
+{
+	if (lt == NULL)
+	{
+		return -1;
+	}
+
+	vector_clear(&lt->records);
+	vector_clear(&lt->data);
+	return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#pragma once
+
+#include "syntax.h"
+#include "vector.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Type layout of target, computed once after parsing and shared with encoder */
+typedef struct layout
+{
+	const syntax *sx;			/**< Syntax structure */
+
+	size_t word_size;			/**< Size of non-floating scalar types */
+	size_t floating_size;		/**< Size of floating types */
+
+	vector records;				/**< Start of structure record in data by type */
+	vector data;				/**< Structure records: size, alignment and member offsets */
+} layout;
+
+
+/**
+ *	Create type layout of target with records of all structure types
+ *
+ *	@param	sx				Syntax structure
+ *	@param	word_size		Size of non-floating scalar types
+ *	@param	floating_size	Size of floating types
+ *
+ *	@return	Type layout
+ */
+layout layout_create(const syntax *const sx, const size_t word_size, const size_t floating_size);
+
+/**
+ *	Get size of type
+ *
+ *	@param	lt				Type layout
+ *	@param	type			Type
+ *
+ *	@return	Size of type
+ */
+size_t layout_get_size(const layout *const lt, const item_t type);
+
+/**
+ *	Get alignment of type
+ *
+ *	@param	lt				Type layout
+ *	@param	type			Type
+ *
+ *	@return	Alignment of type
+ */
+size_t layout_get_alignment(const layout *const lt, const item_t type);
+
+/**
+ *	Get offset of structure member
+ *
+ *	@param	lt				Type layout
+ *	@param	type			Structure type
+ *	@param	index			Member number
+ *
+ *	@return	Offset of member, @c SIZE_MAX on failure
+ */
+size_t layout_get_member_offset(const layout *const lt, const item_t type, const size_t index);
+
+/**
+ *	Free allocated memory
+ *
+ *	@param	lt				Type layout
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+int layout_clear(layout *const lt);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
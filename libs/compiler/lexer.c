@@ -15,11 +15,16 @@
  */
 
 #include "lexer.h"
-#include <math.h>
+#include <stdlib.h>
 #include <string.h>
+#include "decimal.h"
+#include "keywords.h"
 #include "uniscanner.h"
 
 
+static const int64_t MAX_EXPONENT = 100000;
+
+
 /**
  *	Emit an error from lexer
  *
@@ -61,10 +66,19 @@ static inline char32_t scan(lexer *const lxr)
  */
 static inline char32_t lookahead(lexer *const lxr)
 {
-	const size_t position = in_get_position(lxr->sx->io);
-	const char32_t result = uni_scan_char(lxr->sx->io);
-	in_set_position(lxr->sx->io, position);
-	return result;
+	return in_peek_char(lxr->sx->io);
+}
+
+/**
+ *	Check if character is whitespace
+ *
+ *	@param	character	Character
+ *
+ *	@return	@c true on space, tab or newline
+ */
+static inline bool is_blank(const char32_t character)
+{
+	return character == '\n' || character == '\r' || character == '\t' || character == ' ';
 }
 
 /**
@@ -74,8 +88,13 @@ static inline char32_t lookahead(lexer *const lxr)
  */
 static inline void skip_whitespace(lexer *const lxr)
 {
-	while (lxr->character == '\n' || lxr->character == '\r'
-		|| lxr->character == '\t' || lxr->character == ' ')
+	if (is_blank(lxr->character) && in_skip_blank(lxr->sx->io) == 0)
+	{
+		scan(lxr);
+		return;
+	}
+
+	while (is_blank(lxr->character))
 	{
 		scan(lxr);
 	}
@@ -88,6 +107,12 @@ static inline void skip_whitespace(lexer *const lxr)
  */
 static inline void skip_line_comment(lexer *const lxr)
 {
+	if (lxr->character != '\n' && lxr->character != (char32_t)EOF && in_skip_until(lxr->sx->io, "\n") == 0)
+	{
+		scan(lxr);
+		return;
+	}
+
 	while (lxr->character != '\n' && lxr->character != (char32_t)EOF)
 	{
 		scan(lxr);
@@ -101,7 +126,12 @@ static inline void skip_line_comment(lexer *const lxr)
  */
 static inline void skip_block_comment(lexer *const lxr)
 {
-	while (lxr->character != '*' || scan(lxr) != '/')
+	// Opening '*' is not a part of terminating "*/"
+	in_skip_until(lxr->sx->io, "*/");
+	scan(lxr);
+
+	char32_t previous = '\0';
+	while (previous != '*' || lxr->character != '/')
 	{
 		if (lxr->character == (char32_t)EOF)
 		{
@@ -109,12 +139,47 @@ static inline void skip_block_comment(lexer *const lxr)
 			return;
 		}
 
+		previous = lxr->character;
 		scan(lxr);
 	}
 
 	scan(lxr);
 }
 
+/**
+ *	Append character to the spelling of the current token
+ *
+ *	@param	lxr			Lexer
+ *	@param	length		Current length of spelling
+ *	@param	character	Character to append
+ *
+ *	@return	New length of spelling
+ */
+static inline size_t add_spelling(lexer *const lxr, const size_t length, const char32_t character)
+{
+	if (lxr->was_spelling_error)
+	{
+		return length;
+	}
+
+	if (length + MAX_SYMBOL_SIZE >= lxr->spelling_size)
+	{
+		const size_t size = lxr->spelling_size != 0 ? 2 * lxr->spelling_size : MAX_STRING_LENGTH;
+		char *const spelling = realloc(lxr->spelling, size);
+		if (spelling == NULL)
+		{
+			lexer_error(lxr, spelling_out_of_memory);
+			lxr->was_spelling_error = true;
+			return length;
+		}
+
+		lxr->spelling = spelling;
+		lxr->spelling_size = size;
+	}
+
+	return length + utf8_to_string(&lxr->spelling[length], character);
+}
+
 /**
  *	Lex identifier or keyword
  *
@@ -127,18 +192,29 @@ static token lex_identifier_or_keyword(lexer *const lxr)
 	assert(utf8_is_letter(lxr->character) || lxr->character == '#');
 	const size_t loc_begin = in_get_position(lxr->sx->io);
 
-	uni_unscan_char(lxr->sx->io, lxr->character);
-	const size_t repr = repr_reserve(lxr->sx, &lxr->character);
+	size_t length = 0;
+	do
+	{
+		length = add_spelling(lxr, length, lxr->character);
+		scan(lxr);
+	} while (utf8_is_letter(lxr->character) || utf8_is_digit(lxr->character));
 
 	const size_t loc_end = in_get_position(lxr->sx->io);
-	const item_t ref = repr_get_reference(lxr->sx, repr);
+	if (lxr->was_spelling_error)
+	{
+		// Без памяти под лексему разбор продолжать бессмысленно
+		return token_eof();
+	}
 
-	if (ref >= 0)
+	// Ключевые слова не попадают в таблицу representations
+	const keyword *const kw = keyword_find(lxr->spelling, length);
+	if (kw != NULL && kw->reference < 0)
 	{
-		return token_identifier((location){ loc_begin, loc_end }, repr);
+		return token_keyword((location){ loc_begin, loc_end }, (token_t)kw->reference);
 	}
 
-	return token_keyword((location){ loc_begin, loc_end }, (token_t)ref);
+	const size_t repr = repr_reserve(lxr->sx, lxr->spelling);
+	return token_identifier((location){ loc_begin, loc_end }, repr);
 }
 
 /**
@@ -195,6 +271,8 @@ static token lex_numeric_literal(lexer *const lxr)
 	// Переменные для подсчета значения
 	uint64_t int_value = 0;
 	double float_value = 0.0;
+	decimal dec = decimal_create();
+	size_t length = 0;
 	bool is_in_range = true;
 	bool is_integer = true;
 
@@ -240,6 +318,12 @@ static token lex_numeric_literal(lexer *const lxr)
 			float_value = float_value * base + digit;
 		}
 
+		if (base == 10)
+		{
+			decimal_add_digit(&dec, digit);
+			length = add_spelling(lxr, length, lxr->character);
+		}
+
 		scan(lxr);
 	}
 
@@ -252,13 +336,13 @@ static token lex_numeric_literal(lexer *const lxr)
 		}
 
 		is_integer = false;
-		double position_mult = 0.1;
+		length = add_spelling(lxr, length, '.');
 		// Читаем только десятичные цифры
 		// Все остальное относится к следюущим токенам
 		while (utf8_is_digit(scan(lxr)))
 		{
-			float_value += utf8_to_number(lxr->character) * position_mult;
-			position_mult *= 0.1;
+			decimal_add_fraction(&dec, utf8_to_number(lxr->character));
+			length = add_spelling(lxr, length, lxr->character);
 		}
 	}
 
@@ -267,6 +351,7 @@ static token lex_numeric_literal(lexer *const lxr)
 	{
 		int64_t power = 0;	// Показатель степени
 		int sign = 1;		// Знак степени
+		length = add_spelling(lxr, length, 'e');
 		scan(lxr);
 
 		if (lxr->character == '-')
@@ -277,6 +362,7 @@ static token lex_numeric_literal(lexer *const lxr)
 			}
 
 			is_integer = false;
+			length = add_spelling(lxr, length, '-');
 			scan(lxr);
 			sign = -1;
 		}
@@ -302,23 +388,36 @@ static token lex_numeric_literal(lexer *const lxr)
 
 		while (utf8_is_digit(lxr->character))
 		{
-			power = power * 10 + utf8_to_number(lxr->character);
+			// Большие показатели дают бесконечность или ноль и без переполнения
+			if (power < MAX_EXPONENT)
+			{
+				power = power * 10 + utf8_to_number(lxr->character);
+			}
+
+			length = add_spelling(lxr, length, lxr->character);
 			scan(lxr);
 		}
 
-		if (is_integer)
+		// Умножение до переполнения, дальше число считается вещественным
+		for (int64_t i = 0; is_integer && int_value != 0 && i < power; i++)
 		{
-			for (int64_t i = 0; i < power; i++)
+			if (decimal_add_integer_digit(&int_value, 10, 0))
 			{
-				int_value *= 10;
+				is_in_range = false;
+				is_integer = false;
 			}
 		}
 
-		float_value *= pow(10.0, sign * (double)power);
+		dec.exponent += sign * power;
 	}
 
 	// Формируем результат
 	const size_t loc_end = in_get_position(lxr->sx->io);
+	if (lxr->was_spelling_error)
+	{
+		return token_eof();
+	}
+
 	if (is_integer)
 	{
 		return token_int_literal((location){ loc_begin, loc_end }, int_value);
@@ -331,6 +430,12 @@ static token lex_numeric_literal(lexer *const lxr)
 			warning(lxr->sx->io, too_long_int);
 		}
 
+		if (base == 10)
+		{
+			lxr->spelling[length] = '\0';
+			float_value = decimal_to_double(&dec, lxr->spelling);
+		}
+
 		return token_float_literal((location){ loc_begin, loc_end }, float_value);
 	}
 }
@@ -443,40 +548,15 @@ static token lex_string_literal(lexer *const lxr)
 }
 
 
-/*
- *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
- *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
- *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
- *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
- *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+/**
+ *	Lex next token directly from io
+ *
+ *	@param	lxr			Lexer
+ *
+ *	@return	Lexed token
  */
-
-
-lexer lexer_create(syntax *const sx)
+static token lex_token(lexer *const lxr)
 {
-	lexer lxr;
-
-	lxr.sx = sx;
-	lxr.lexstr = vector_create(MAX_STRING_LENGTH);
-
-	scan(&lxr);
-
-	return lxr;
-}
-
-int lexer_clear(lexer *const lxr)
-{
-	return vector_clear(&lxr->lexstr);
-}
-
-
-token lex(lexer *const lxr)
-{
-	if (lxr == NULL)
-	{
-		return token_eof();
-	}
-
 	while (true)
 	{
 		skip_whitespace(lxr);
@@ -809,12 +889,82 @@ token lex(lexer *const lxr)
 	}
 }
 
+
+/*
+ *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
+ *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
+ *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
+ *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
+ *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+ */
+
+
+lexer lexer_create(syntax *const sx)
+{
+	lexer lxr;
+
+	lxr.sx = sx;
+	lxr.lexstr = vector_create(MAX_STRING_LENGTH);
+
+	// При нехватке памяти выделение повторится на первой лексеме, там же будет ошибка
+	lxr.spelling = malloc(MAX_STRING_LENGTH);
+	lxr.spelling_size = lxr.spelling != NULL ? MAX_STRING_LENGTH : 0;
+	lxr.was_spelling_error = false;
+
+	lxr.lookahead_begin = 0;
+	lxr.lookahead_size = 0;
+
+	scan(&lxr);
+
+	return lxr;
+}
+
+int lexer_clear(lexer *const lxr)
+{
+	free(lxr->spelling);
+	lxr->spelling = NULL;
+
+	return vector_clear(&lxr->lexstr);
+}
+
+
+token lex(lexer *const lxr)
+{
+	if (lxr == NULL)
+	{
+		return token_eof();
+	}
+
+	if (lxr->lookahead_size == 0)
+	{
+		return lex_token(lxr);
+	}
+
+	const token tk = lxr->lookahead[lxr->lookahead_begin];
+	lxr->lookahead_begin = (lxr->lookahead_begin + 1) % MAX_LOOKAHEAD;
+	lxr->lookahead_size--;
+	return tk;
+}
+
 token_t peek(lexer *const lxr)
 {
-	const size_t position = in_get_position(lxr->sx->io);
-	const char32_t character = lxr->character;
-	const token peek_token = lex(lxr);
-	lxr->character = character;
-	in_set_position(lxr->sx->io, position);
-	return token_get_kind(&peek_token);
+	return peek_ahead(lxr, 1);
+}
+
+token_t peek_ahead(lexer *const lxr, const size_t distance)
+{
+	if (lxr == NULL || distance == 0 || distance > MAX_LOOKAHEAD)
+	{
+		return TK_EOF;
+	}
+
+	while (lxr->lookahead_size < distance)
+	{
+		const size_t index = (lxr->lookahead_begin + lxr->lookahead_size) % MAX_LOOKAHEAD;
+		lxr->lookahead[index] = lex_token(lxr);
+		lxr->lookahead_size++;
+	}
+
+	const size_t index = (lxr->lookahead_begin + distance - 1) % MAX_LOOKAHEAD;
+	return token_get_kind(&lxr->lookahead[index]);
 }
@@ -24,6 +24,9 @@
 #include "workspace.h"
 
 
+#define MAX_LOOKAHEAD 4
+
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -35,6 +38,14 @@ typedef struct lexer
 
 	char32_t character;						/**< Current character */
 	vector lexstr;							/**< Representation of the read string literal */
+
+	char *spelling;							/**< Spelling of the read identifier */
+	size_t spelling_size;					/**< Allocated size of spelling */
+	bool was_spelling_error;				/**< Set if spelling could not be allocated */
+
+	token lookahead[MAX_LOOKAHEAD];			/**< Ring buffer of already lexed tokens */
+	size_t lookahead_begin;					/**< Index of the first buffered token */
+	size_t lookahead_size;					/**< Number of buffered tokens */
 } lexer;
 
 /**
@@ -64,6 +75,16 @@ token lex(lexer *const lxr);
  */
 token_t peek(lexer *const lxr);
 
+/**
+ *	Peek token at given distance from io
+ *
+ *	@param	lxr			Lexer
+ *	@param	distance	Distance to token, from @c 1 to @c MAX_LOOKAHEAD
+ *
+ *	@return	Peeked token kind
+ */
+token_t peek_ahead(lexer *const lxr, const size_t distance);
+
 /**
  *	Free allocated memory
  *
@@ -692,11 +692,8 @@ static void global_initialization(information *const info)
 {
 	const node root = node_get_root(&info->sx->tree);
 
-	const size_t size = translation_unit_get_size(&root);
-	for (size_t i = 0; i < size; i++)
+	for (node decl = translation_unit_get_declaration(&root, 0); node_is_correct(&decl); decl = node_get_sibling(&decl))
 	{
-		const node decl = translation_unit_get_declaration(&root, i);
-
 		if (declaration_get_class(&decl) == DECL_VAR)
 		{
 			const size_t id = declaration_variable_get_id(&decl);
@@ -1019,10 +1016,10 @@ static void emit_call_expression(information *const info, const node *const nd)
 		func_reg = info->register_num++;
 	}
 
-	for (size_t i = 0; i < args; i++)
+	node argument = expression_call_get_argument(nd, 0);
+	for (size_t i = 0; i < args; i++, argument = node_get_sibling(&argument))
 	{
 		info->variable_location = LFREE;
-		const node argument = expression_call_get_argument(nd, i);
 		arguments_value_type[i] = expression_get_type(&argument);
 		if (!type_is_function(info->sx, arguments_value_type[i]))
 		{
@@ -1266,7 +1263,7 @@ static void emit_inc_dec_expression(information *const info, const node *const n
 		id = (size_t)info->answer_reg;
 	}
 
-	to_code_load(info, info->register_num, id, operation_type, is_complex, ident_is_local(info->sx, id));
+	to_code_load(info, info->register_num, id, operation_type, is_complex, !is_complex ? ident_is_local(info->sx, id) : true);
 	info->answer_kind = AREG;
 	info->answer_reg = info->register_num++;
 
@@ -1294,7 +1291,7 @@ static void emit_inc_dec_expression(information *const info, const node *const n
 			break;
 	}
 
-	to_code_store_reg(info, info->register_num, id, operation_type, is_complex, false, ident_is_local(info->sx, id));
+	to_code_store_reg(info, info->register_num, id, operation_type, is_complex, false, !is_complex ? ident_is_local(info->sx, id) : true);
 	info->register_num++;
 }
 
@@ -1622,7 +1619,7 @@ static void emit_assignment_expression(information *const info, const node *cons
 
 	if (assignment_type != BIN_ASSIGN)
 	{
-		to_code_load(info, info->register_num, id, operation_type, is_complex, ident_is_local(info->sx, id));
+		to_code_load(info, info->register_num, id, operation_type, is_complex, !is_complex ? ident_is_local(info->sx, id) : true);
 		info->register_num++;
 
 		if (info->answer_kind == AREG)
@@ -2068,7 +2065,8 @@ static void emit_initialization(information *const info, const node *const nd, c
 		}
 
 		const item_t type = array_get_type(info, arr_type);
-		const bool is_local = ident_is_local(info->sx, (size_t)id);
+		// Временные массивы инициализаторов-аргументов имеют отрицательный номер и всегда локальны
+		const bool is_local = id < 0 || ident_is_local(info->sx, (size_t)id);
 
 		// TODO: с глобальными массивами хорошо бы как-то покрасивее сделать
 		// а неконстантными выражениями глобальный массив может инициализироваться?
@@ -2545,14 +2543,13 @@ static void emit_compound_statement(information *const info, const node *const n
 		to_code_stack_save(info, block_num);
 	}
 
-	const size_t size = statement_compound_get_size(nd);
-	for (size_t i = 0; i < size; i++)
+	for (node substmt = statement_compound_get_substmt(nd, 0); node_is_correct(&substmt); substmt = node_get_sibling(&substmt))
 	{
-		const node substmt = statement_compound_get_substmt(nd, i);
 		emit_statement(info, &substmt);
 
-		if ((statement_get_class(&substmt) == STMT_CASE || statement_get_class(&substmt) == STMT_DEFAULT)
-			&& i == size - 1)
+		const node next = node_get_sibling(&substmt);
+		const bool is_last = !node_is_correct(&next);
+		if ((statement_get_class(&substmt) == STMT_CASE || statement_get_class(&substmt) == STMT_DEFAULT) && is_last)
 		{
 			if (!is_function_body)
 			{
@@ -2560,7 +2557,7 @@ static void emit_compound_statement(information *const info, const node *const n
 			}
 			to_code_unconditional_branch(info, info->label_switch);
 		}
-		else if (i == size - 1)
+		else if (is_last)
 		{
 			if (!is_function_body)
 			{
@@ -2869,11 +2866,8 @@ static void emit_switch_statement(information *const info, const node *const nd)
 	int has_default = 0;
 	if (statement_get_class(&body) == STMT_COMPOUND)
 	{
-		const size_t size = statement_compound_get_size(&body);
-		for (size_t i = 0; i < size; i++)
+		for (node substmt = statement_compound_get_substmt(&body, 0); node_is_correct(&substmt); substmt = node_get_sibling(&substmt))
 		{
-			const node substmt = statement_compound_get_substmt(&body, i);
-
 			if (statement_get_class(&substmt) == STMT_CASE)
 			{
 				const node expr = statement_case_get_expression(&substmt);
@@ -2916,10 +2910,8 @@ static void emit_switch_statement(information *const info, const node *const nd)
  */
 static void emit_declaration_statement(information *const info, const node *const nd)
 {
-	const size_t size = statement_declaration_get_size(nd);
-	for (size_t i = 0; i < size; i++)
+	for (node decl = statement_declaration_get_declarator(nd, 0); node_is_correct(&decl); decl = node_get_sibling(&decl))
 	{
-		const node decl = statement_declaration_get_declarator(nd, i);
 		emit_declaration(info, &decl, true);
 	}
 }
@@ -3003,10 +2995,8 @@ static void emit_statement(information *const info, const node *const nd)
  */
 static int emit_translation_unit(information *const info, const node *const nd)
 {
-	const size_t size = translation_unit_get_size(nd);
-	for (size_t i = 0; i < size; i++)
+	for (node decl = translation_unit_get_declaration(nd, 0); node_is_correct(&decl); decl = node_get_sibling(&decl))
 	{
-		const node decl = translation_unit_get_declaration(nd, i);
 		emit_declaration(info, &decl, false);
 	}
 
@@ -3219,8 +3209,9 @@ static void runtime(information *const info)
  */
 
 
-int encode_to_llvm(const workspace *const ws, syntax *const sx)
+int encode_to_llvm(const workspace *const ws, syntax *const sx, const layout *const lt)
 {
+	(void)lt;
 	if (!ws_is_correct(ws) || sx == NULL)
 	{
 		return -1;
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "layout.h"
 #include "syntax.h"
 #include "workspace.h"
 
@@ -29,10 +30,11 @@ extern "C" {
  *
  *	@param	ws				Compiler workspace
  *	@param	sx				Syntax structure
+ *	@param	lt				Type layout, not used since members are addressed by index
  *
  *	@return	@c 0 on success, @c -1 on failure
  */
-int encode_to_llvm(const workspace *const ws, syntax *const sx);
+int encode_to_llvm(const workspace *const ws, syntax *const sx, const layout *const lt);
 
 #ifdef __cplusplus
 } /* extern "C" */
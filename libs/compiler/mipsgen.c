@@ -17,6 +17,7 @@
 #include "mipsgen.h"
 #include "AST.h"
 #include "hash.h"
+#include "layout.h"
 #include "operations.h"
 #include "tree.h"
 #include "uniprinter.h"
@@ -31,7 +32,7 @@ static const size_t BUFFER_SIZE = 65536;			/**< Размер буфера для
 static const size_t HASH_TABLE_SIZE = 1024;			/**< Размер хеш-таблицы для смещений и регистров */
 static const bool IS_ON_STACK = true;				/**< Хранится ли переменная на стеке */
 
-static const size_t WORD_LENGTH = 4;				/**< Длина слова данных */
+static const size_t WORD_LENGTH = MIPS_WORD_SIZE;				/**< Длина слова данных */
 static const size_t HALF_WORD_LENGTH = 2;			/**< Длина половины слова данных */
 
 static const size_t LOW_DYN_BORDER = 0x10010000;	/**< Нижняя граница динамической памяти */
@@ -307,6 +308,7 @@ typedef struct encoder
 												@c key		- ссылка на таблицу идентификаторов
 												@c value[0]	- флаг, лежит ли переменная на стеке или в регистре
 												@c value[1]	- смещение или номер регистра */
+	const layout *layout;					/**< Размеры и смещения типов */
 
 	mips_register_t next_register;			/**< Следующий обычный регистр для выделения */
 	mips_register_t next_float_register;	/**< Следующий регистр с плавающей точкой для выделения */
@@ -339,25 +341,6 @@ static void emit_structure_init(encoder *const enc, const lvalue *const target,
 static void emit_statement(encoder *const enc, const node *const nd);
 
 
-static size_t mips_type_size(const syntax *const sx, const item_t type)
-{
-	if (type_is_structure(sx, type))
-	{
-		size_t size = 0;
-		const size_t amount = type_structure_get_member_amount(sx, type);
-		for (size_t i = 0; i < amount; i++)
-		{
-			const item_t member_type = type_structure_get_member_type(sx, type, i);
-			size += mips_type_size(sx, member_type);
-		}
-		return size;
-	}
-	else
-	{
-		return WORD_LENGTH;
-	}
-}
-
 /**
  *	Locks certain register
  *
@@ -608,207 +591,207 @@ static void mips_register_to_io(universal_io *const io, const mips_register_t re
 	switch (reg)
 	{
 		case R_ZERO:
-			uni_printf(io, "$0");
+			uni_print_str(io, "$0");
 			break;
 		case R_AT:
-			uni_printf(io, "$at");
+			uni_print_str(io, "$at");
 			break;
 
 		case R_V0:
-			uni_printf(io, "$v0");
+			uni_print_str(io, "$v0");
 			break;
 		case R_V1:
-			uni_printf(io, "$v1");
+			uni_print_str(io, "$v1");
 			break;
 
 		case R_A0:
-			uni_printf(io, "$a0");
+			uni_print_str(io, "$a0");
 			break;
 		case R_A1:
-			uni_printf(io, "$a1");
+			uni_print_str(io, "$a1");
 			break;
 		case R_A2:
-			uni_printf(io, "$a2");
+			uni_print_str(io, "$a2");
 			break;
 		case R_A3:
-			uni_printf(io, "$a3");
+			uni_print_str(io, "$a3");
 			break;
 
 		case R_T0:
-			uni_printf(io, "$t0");
+			uni_print_str(io, "$t0");
 			break;
 		case R_T1:
-			uni_printf(io, "$t1");
+			uni_print_str(io, "$t1");
 			break;
 		case R_T2:
-			uni_printf(io, "$t2");
+			uni_print_str(io, "$t2");
 			break;
 		case R_T3:
-			uni_printf(io, "$t3");
+			uni_print_str(io, "$t3");
 			break;
 		case R_T4:
-			uni_printf(io, "$t4");
+			uni_print_str(io, "$t4");
 			break;
 		case R_T5:
-			uni_printf(io, "$t5");
+			uni_print_str(io, "$t5");
 			break;
 		case R_T6:
-			uni_printf(io, "$t6");
+			uni_print_str(io, "$t6");
 			break;
 		case R_T7:
-			uni_printf(io, "$t7");
+			uni_print_str(io, "$t7");
 			break;
 
 		case R_S0:
-			uni_printf(io, "$s0");
+			uni_print_str(io, "$s0");
 			break;
 		case R_S1:
-			uni_printf(io, "$s1");
+			uni_print_str(io, "$s1");
 			break;
 		case R_S2:
-			uni_printf(io, "$s2");
+			uni_print_str(io, "$s2");
 			break;
 		case R_S3:
-			uni_printf(io, "$s3");
+			uni_print_str(io, "$s3");
 			break;
 		case R_S4:
-			uni_printf(io, "$s4");
+			uni_print_str(io, "$s4");
 			break;
 		case R_S5:
-			uni_printf(io, "$s5");
+			uni_print_str(io, "$s5");
 			break;
 		case R_S6:
-			uni_printf(io, "$s6");
+			uni_print_str(io, "$s6");
 			break;
 		case R_S7:
-			uni_printf(io, "$s7");
+			uni_print_str(io, "$s7");
 			break;
 
 		case R_T8:
-			uni_printf(io, "$t8");
+			uni_print_str(io, "$t8");
 			break;
 		case R_T9:
-			uni_printf(io, "$t9");
+			uni_print_str(io, "$t9");
 			break;
 
 		case R_K0:
-			uni_printf(io, "$k0");
+			uni_print_str(io, "$k0");
 			break;
 		case R_K1:
-			uni_printf(io, "$k1");
+			uni_print_str(io, "$k1");
 			break;
 
 		case R_GP:
-			uni_printf(io, "$gp");
+			uni_print_str(io, "$gp");
 			break;
 		case R_SP:
-			uni_printf(io, "$sp");
+			uni_print_str(io, "$sp");
 			break;
 		case R_FP:
-			uni_printf(io, "$fp");
+			uni_print_str(io, "$fp");
 			break;
 		case R_RA:
-			uni_printf(io, "$ra");
+			uni_print_str(io, "$ra");
 			break;
 
 		case R_FV0:
-			uni_printf(io, "$f0");
+			uni_print_str(io, "$f0");
 			break;
 		case R_FV1:
-			uni_printf(io, "$f1");
+			uni_print_str(io, "$f1");
 			break;
 		case R_FV2:
-			uni_printf(io, "$f2");
+			uni_print_str(io, "$f2");
 			break;
 		case R_FV3:
-			uni_printf(io, "$f3");
+			uni_print_str(io, "$f3");
 			break;
 
 		case R_FT0:
-			uni_printf(io, "$f4");
+			uni_print_str(io, "$f4");
 			break;
 		case R_FT1:
-			uni_printf(io, "$f5");
+			uni_print_str(io, "$f5");
 			break;
 		case R_FT2:
-			uni_printf(io, "$f6");
+			uni_print_str(io, "$f6");
 			break;
 		case R_FT3:
-			uni_printf(io, "$f7");
+			uni_print_str(io, "$f7");
 			break;
 		case R_FT4:
-			uni_printf(io, "$f8");
+			uni_print_str(io, "$f8");
 			break;
 		case R_FT5:
-			uni_printf(io, "$f9");
+			uni_print_str(io, "$f9");
 			break;
 		case R_FT6:
-			uni_printf(io, "$f10");
+			uni_print_str(io, "$f10");
 			break;
 		case R_FT7:
-			uni_printf(io, "$f11");
+			uni_print_str(io, "$f11");
 			break;
 		case R_FT8:
-			uni_printf(io, "$f16");
+			uni_print_str(io, "$f16");
 			break;
 		case R_FT9:
-			uni_printf(io, "$f17");
+			uni_print_str(io, "$f17");
 			break;
 		case R_FT10:
-			uni_printf(io, "$f18");
+			uni_print_str(io, "$f18");
 			break;
 		case R_FT11:
-			uni_printf(io, "$f19");
+			uni_print_str(io, "$f19");
 			break;
 
 		case R_FA0:
-			uni_printf(io, "$f12");
+			uni_print_str(io, "$f12");
 			break;
 		case R_FA1:
-			uni_printf(io, "$f13");
+			uni_print_str(io, "$f13");
 			break;
 		case R_FA2:
-			uni_printf(io, "$f14");
+			uni_print_str(io, "$f14");
 			break;
 		case R_FA3:
-			uni_printf(io, "$f15");
+			uni_print_str(io, "$f15");
 			break;
 
 		case R_FS0:
-			uni_printf(io, "$f20");
+			uni_print_str(io, "$f20");
 			break;
 		case R_FS1:
-			uni_printf(io, "$f21");
+			uni_print_str(io, "$f21");
 			break;
 		case R_FS2:
-			uni_printf(io, "$f22");
+			uni_print_str(io, "$f22");
 			break;
 		case R_FS3:
-			uni_printf(io, "$f23");
+			uni_print_str(io, "$f23");
 			break;
 		case R_FS4:
-			uni_printf(io, "$f24");
+			uni_print_str(io, "$f24");
 			break;
 		case R_FS5:
-			uni_printf(io, "$f25");
+			uni_print_str(io, "$f25");
 			break;
 		case R_FS6:
-			uni_printf(io, "$f26");
+			uni_print_str(io, "$f26");
 			break;
 		case R_FS7:
-			uni_printf(io, "$f27");
+			uni_print_str(io, "$f27");
 			break;
 		case R_FS8:
-			uni_printf(io, "$f28");
+			uni_print_str(io, "$f28");
 			break;
 		case R_FS9:
-			uni_printf(io, "$f29");
+			uni_print_str(io, "$f29");
 			break;
 		case R_FS10:
-			uni_printf(io, "$f30");
+			uni_print_str(io, "$f30");
 			break;
 		case R_FS11:
-			uni_printf(io, "$f31");
+			uni_print_str(io, "$f31");
 			break;
 	}
 }
@@ -818,162 +801,162 @@ static void instruction_to_io(universal_io *const io, const mips_instruction_t i
 	switch (instruction)
 	{
 		case IC_MIPS_MOVE:
-			uni_printf(io, "move");
+			uni_print_str(io, "move");
 			break;
 		case IC_MIPS_LI:
-			uni_printf(io, "li");
+			uni_print_str(io, "li");
 			break;
 		case IC_MIPS_LA:
-			uni_printf(io, "la");
+			uni_print_str(io, "la");
 			break;
 		case IC_MIPS_NOT:
-			uni_printf(io, "not");
+			uni_print_str(io, "not");
 			break;
 
 		case IC_MIPS_ADDI:
-			uni_printf(io, "addi");
+			uni_print_str(io, "addi");
 			break;
 		case IC_MIPS_SLL:
-			uni_printf(io, "sll");
+			uni_print_str(io, "sll");
 			break;
 		case IC_MIPS_SRA:
-			uni_printf(io, "sra");
+			uni_print_str(io, "sra");
 			break;
 		case IC_MIPS_ANDI:
-			uni_printf(io, "andi");
+			uni_print_str(io, "andi");
 			break;
 		case IC_MIPS_XORI:
-			uni_printf(io, "xori");
+			uni_print_str(io, "xori");
 			break;
 		case IC_MIPS_ORI:
-			uni_printf(io, "ori");
+			uni_print_str(io, "ori");
 			break;
 
 		case IC_MIPS_ADD:
-			uni_printf(io, "add");
+			uni_print_str(io, "add");
 			break;
 		case IC_MIPS_SUB:
-			uni_printf(io, "sub");
+			uni_print_str(io, "sub");
 			break;
 		case IC_MIPS_MUL:
-			uni_printf(io, "mul");
+			uni_print_str(io, "mul");
 			break;
 		case IC_MIPS_DIV:
-			uni_printf(io, "div");
+			uni_print_str(io, "div");
 			break;
 		case IC_MIPS_MOD:
-			uni_printf(io, "mod");
+			uni_print_str(io, "mod");
 			break;
 		case IC_MIPS_SLLV:
-			uni_printf(io, "sllv");
+			uni_print_str(io, "sllv");
 			break;
 		case IC_MIPS_SRAV:
-			uni_printf(io, "srav");
+			uni_print_str(io, "srav");
 			break;
 		case IC_MIPS_AND:
-			uni_printf(io, "and");
+			uni_print_str(io, "and");
 			break;
 		case IC_MIPS_XOR:
-			uni_printf(io, "xor");
+			uni_print_str(io, "xor");
 			break;
 		case IC_MIPS_OR:
-			uni_printf(io, "or");
+			uni_print_str(io, "or");
 			break;
 
 		case IC_MIPS_SW:
-			uni_printf(io, "sw");
+			uni_print_str(io, "sw");
 			break;
 		case IC_MIPS_LW:
-			uni_printf(io, "lw");
+			uni_print_str(io, "lw");
 			break;
 
 		case IC_MIPS_JR:
-			uni_printf(io, "jr");
+			uni_print_str(io, "jr");
 			break;
 		case IC_MIPS_JAL:
-			uni_printf(io, "jal");
+			uni_print_str(io, "jal");
 			break;
 		case IC_MIPS_J:
-			uni_printf(io, "j");
+			uni_print_char(io, 'j');
 			break;
 
 		case IC_MIPS_BLEZ:
-			uni_printf(io, "blez");
+			uni_print_str(io, "blez");
 			break;
 		case IC_MIPS_BLTZ:
-			uni_printf(io, "bltz");
+			uni_print_str(io, "bltz");
 			break;
 		case IC_MIPS_BGEZ:
-			uni_printf(io, "bgez");
+			uni_print_str(io, "bgez");
 			break;
 		case IC_MIPS_BGTZ:
-			uni_printf(io, "bgtz");
+			uni_print_str(io, "bgtz");
 			break;
 		case IC_MIPS_BEQ:
-			uni_printf(io, "beq");
+			uni_print_str(io, "beq");
 			break;
 		case IC_MIPS_BNE:
-			uni_printf(io, "bne");
+			uni_print_str(io, "bne");
 			break;
 
 		case IC_MIPS_SLTIU:
-			uni_printf(io, "sltiu");
+			uni_print_str(io, "sltiu");
 			break;
 
 		case IC_MIPS_NOP:
-			uni_printf(io, "nop");
+			uni_print_str(io, "nop");
 			break;
 
 		case IC_MIPS_ADD_S:
-			uni_printf(io, "add.s");
+			uni_print_str(io, "add.s");
 			break;
 		case IC_MIPS_SUB_S:
-			uni_printf(io, "sub.s");
+			uni_print_str(io, "sub.s");
 			break;
 		case IC_MIPS_MUL_S:
-			uni_printf(io, "mul.s");
+			uni_print_str(io, "mul.s");
 			break;
 		case IC_MIPS_DIV_S:
-			uni_printf(io, "div.s");
+			uni_print_str(io, "div.s");
 			break;
 
 		case IC_MIPS_ABS_S:
-			uni_printf(io, "abs.s");
+			uni_print_str(io, "abs.s");
 			break;
 		case IC_MIPS_ABS:
-			uni_printf(io, "abs");
+			uni_print_str(io, "abs");
 			break;
 
 		case IC_MIPS_S_S:
-			uni_printf(io, "s.s");
+			uni_print_str(io, "s.s");
 			break;
 		case IC_MIPS_L_S:
-			uni_printf(io, "l.s");
+			uni_print_str(io, "l.s");
 			break;
 
 		case IC_MIPS_LI_S:
-			uni_printf(io, "li.s");
+			uni_print_str(io, "li.s");
 			break;
 
 		case IC_MIPS_MOV_S:
-			uni_printf(io, "mov.s");
+			uni_print_str(io, "mov.s");
 			break;
 
 		case IC_MIPS_MFC_1:
-			uni_printf(io, "mfc1");
+			uni_print_str(io, "mfc1");
 			break;
 		case IC_MIPS_MFHC_1:
-			uni_printf(io, "mfhc1");
+			uni_print_str(io, "mfhc1");
 			break;
 
 		case IC_MIPS_CVT_D_S:
-			uni_printf(io, "cvt.d.s");
+			uni_print_str(io, "cvt.d.s");
 			break;
 		case IC_MIPS_CVT_S_W:
-			uni_printf(io, "cvt.s.w");
+			uni_print_str(io, "cvt.s.w");
 			break;
 		case IC_MIPS_CVT_W_S:
-			uni_printf(io, "cvt.w.s");
+			uni_print_str(io, "cvt.w.s");
 			break;
 	}
 }
@@ -982,50 +965,56 @@ static void instruction_to_io(universal_io *const io, const mips_instruction_t i
 static void to_code_2R(universal_io *const io, const mips_instruction_t instruction
 	, const mips_register_t fst_reg, const mips_register_t snd_reg)
 {
-	uni_printf(io, "\t");
+	uni_print_char(io, '\t');
 	instruction_to_io(io, instruction);
-	uni_printf(io, " ");
+	uni_print_char(io, ' ');
 	mips_register_to_io(io, fst_reg);
-	uni_printf(io, ", ");
+	uni_print_str(io, ", ");
 	mips_register_to_io(io, snd_reg);
-	uni_printf(io, "\n");
+	uni_print_char(io, '\n');
 }
 
 // Вид инструкции:	instr	fst_reg, snd_reg, imm
 static void to_code_2R_I(universal_io *const io, const mips_instruction_t instruction
 	, const mips_register_t fst_reg, const mips_register_t snd_reg, const item_t imm)
 {
-	uni_printf(io, "\t");
+	uni_print_char(io, '\t');
 	instruction_to_io(io, instruction);
-	uni_printf(io, " ");
+	uni_print_char(io, ' ');
 	mips_register_to_io(io, fst_reg);
-	uni_printf(io, ", ");
+	uni_print_str(io, ", ");
 	mips_register_to_io(io, snd_reg);
-	uni_printf(io, ", %" PRIitem "\n", imm);
+	uni_print_str(io, ", ");
+	uni_print_item(io, imm);
+	uni_print_char(io, '\n');
 }
 
 // Вид инструкции:	instr	fst_reg, imm(snd_reg)
 static void to_code_R_I_R(universal_io *const io, const mips_instruction_t instruction
 	, const mips_register_t fst_reg, const item_t imm, const mips_register_t snd_reg)
 {
-	uni_printf(io, "\t");
+	uni_print_char(io, '\t');
 	instruction_to_io(io, instruction);
-	uni_printf(io, " ");
+	uni_print_char(io, ' ');
 	mips_register_to_io(io, fst_reg);
-	uni_printf(io, ", %" PRIitem "(", imm);
+	uni_print_str(io, ", ");
+	uni_print_item(io, imm);
+	uni_print_char(io, '(');
 	mips_register_to_io(io, snd_reg);
-	uni_printf(io, ")\n");
+	uni_print_str(io, ")\n");
 }
 
 // Вид инструкции:	instr	reg, imm
 static void to_code_R_I(universal_io *const io, const mips_instruction_t instruction
 	, const mips_register_t reg, const item_t imm)
 {
-	uni_printf(io, "\t");
+	uni_print_char(io, '\t');
 	instruction_to_io(io, instruction);
-	uni_printf(io, " ");
+	uni_print_char(io, ' ');
 	mips_register_to_io(io, reg);
-	uni_printf(io, ", %" PRIitem "\n", imm);
+	uni_print_str(io, ", ");
+	uni_print_item(io, imm);
+	uni_print_char(io, '\n');
 }
 
 /**
@@ -1111,7 +1100,7 @@ static lvalue displacements_add(encoder *const enc, const size_t identifier, con
 	const item_t type = ident_get_type(enc->sx, identifier);
 	if (is_local && !is_register)
 	{
-		enc->scope_displ += mips_type_size(enc->sx, type);
+		enc->scope_displ += layout_get_size(enc->layout, type);
 		enc->max_displ = max(enc->scope_displ, enc->max_displ);
 	}
 	const item_t location = is_local ? -(item_t)enc->scope_displ : (item_t)enc->global_displ;
@@ -1129,7 +1118,7 @@ static lvalue displacements_add(encoder *const enc, const size_t identifier, con
 
 	if (!is_local)
 	{
-		enc->global_displ += mips_type_size(enc->sx, type);
+		enc->global_displ += layout_get_size(enc->layout, type);
 	}
 
 	return (lvalue) { .kind = is_register ? LVALUE_KIND_REGISTER : LVALUE_KIND_STACK, .base_reg = base_reg, .loc.displ = location, .type = type };
@@ -1431,7 +1420,7 @@ static lvalue emit_subscript_lvalue(encoder *const enc, const node *const nd)
 		return (lvalue) {
 			.kind = LVALUE_KIND_STACK,
 			.base_reg = base_value.val.reg_num,
-			.loc.displ = -(item_t)index_value.val.int_val * mips_type_size(enc->sx, type),
+			.loc.displ = -(item_t)index_value.val.int_val * layout_get_size(enc->layout, type),
 			.type = type
 		};
 	}
@@ -1439,7 +1428,7 @@ static lvalue emit_subscript_lvalue(encoder *const enc, const node *const nd)
 	const rvalue type_size_value = {	// Можно было бы сделать отдельным конструктором
 		.from_lvalue = !FROM_LVALUE,
 		.kind = RVALUE_KIND_CONST,
-		.val.int_val = mips_type_size(enc->sx, type),
+		.val.int_val = layout_get_size(enc->layout, type),
 		.type = TYPE_INTEGER
 	};
 	const rvalue offset = {
@@ -1474,13 +1463,8 @@ static lvalue emit_member_lvalue(encoder *const enc, const node *const nd)
 	const bool is_arrow = expression_member_is_arrow(nd);
 	const item_t struct_type = is_arrow ? type_pointer_get_element_type(enc->sx, base_type) : base_type;
 
-	size_t member_displ = 0;
 	const size_t member_index = expression_member_get_member_index(nd);
-	for (size_t i = 0; i < member_index; i++)
-	{
-		const item_t member_type = type_structure_get_member_type(enc->sx, struct_type, i);
-		member_displ += mips_type_size(enc->sx, member_type);
-	}
+	const size_t member_displ = layout_get_member_offset(enc->layout, struct_type, member_index);
 
 	const item_t type = expression_get_type(nd);
 
@@ -2197,9 +2181,9 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 
 		// TODO: структуры / массивы в параметры
 		size_t arg_reg_count = 0;
-		for (size_t i = 0; i < params_amount; i++)
+		node arg = expression_call_get_argument(nd, 0);
+		for (size_t i = 0; i < params_amount; i++, arg = node_get_sibling(&arg))
 		{
-			const node arg = expression_call_get_argument(nd, i);
 			const rvalue tmp = emit_expression(enc, &arg);
 			const rvalue arg_rvalue = (tmp.kind == RVALUE_KIND_CONST) ? emit_load_of_immediate(enc, &tmp) : tmp;
 
@@ -2632,7 +2616,7 @@ static rvalue emit_struct_assignment(encoder *const enc, const lvalue *const tar
 
 		// Копирование всех данных из RHS
 		const item_t type = expression_get_type(value);
-		const size_t struct_size = mips_type_size(enc->sx, type);
+		const size_t struct_size = layout_get_size(enc->layout, type);
 		for (size_t i = 0; i < struct_size; i += WORD_LENGTH)
 		{
 			// Грузим данные из RHS
@@ -3084,7 +3068,7 @@ static void emit_structure_init(encoder *const enc, const lvalue *const target,
 			.loc.displ = target->loc.displ + displ,
 			.type = type
 		};
-		displ += mips_type_size(enc->sx, type);
+		displ += layout_get_size(enc->layout, type);
 
 		const node subexpr = expression_initializer_get_subexpr(initializer, i);
 		if (expression_get_class(&subexpr) == EXPR_INITIALIZER)
@@ -3348,10 +3332,8 @@ static void emit_declaration(encoder *const enc, const node *const nd)
  */
 static void emit_declaration_statement(encoder *const enc, const node *const nd)
 {
-	const size_t size = statement_declaration_get_size(nd);
-	for (size_t i = 0; i < size; i++)
+	for (node decl = statement_declaration_get_declarator(nd, 0); node_is_correct(&decl); decl = node_get_sibling(&decl))
 	{
-		const node decl = statement_declaration_get_declarator(nd, i);
 		emit_declaration(enc, &decl);
 	}
 }
@@ -3396,10 +3378,8 @@ static void emit_compound_statement(encoder *const enc, const node *const nd)
 {
 	const size_t scope_displacement = enc->scope_displ;
 
-	const size_t size = statement_compound_get_size(nd);
-	for (size_t i = 0; i < size; i++)
+	for (node substmt = statement_compound_get_substmt(nd, 0); node_is_correct(&substmt); substmt = node_get_sibling(&substmt))
 	{
-		const node substmt = statement_compound_get_substmt(nd, i);
 		emit_statement(enc, &substmt);
 	}
 
@@ -3466,10 +3446,8 @@ static void emit_switch_statement(encoder *const enc, const node *const nd)
 
 	// Размещение меток согласно условиям
 	const node body = statement_switch_get_body(nd);
-	const size_t amount = statement_compound_get_size(&body);	// Гарантируется compound statement
-	for (size_t i = 0; i < amount; i++)
+	for (node substmt = statement_compound_get_substmt(&body, 0); node_is_correct(&substmt); substmt = node_get_sibling(&substmt))
 	{
-		const node substmt = statement_compound_get_substmt(&body, i);
 		const item_t substmt_class = statement_get_class(&substmt);
 
 		if (substmt_class == STMT_CASE)
@@ -3515,9 +3493,8 @@ static void emit_switch_statement(encoder *const enc, const node *const nd)
 	uni_printf(enc->sx->io, "\n");
 
 	// Размещение тел всех case и default statements
-	for (size_t i = 0; i < amount; i++)
+	for (node substmt = statement_compound_get_substmt(&body, 0); node_is_correct(&substmt); substmt = node_get_sibling(&substmt))
 	{
-		const node substmt = statement_compound_get_substmt(&body, i);
 		const item_t substmt_class = statement_get_class(&substmt);
 
 		if (substmt_class == STMT_CASE)
@@ -3787,10 +3764,8 @@ static void emit_statement(encoder *const enc, const node *const nd)
  */
 static int emit_translation_unit(encoder *const enc, const node *const nd)
 {
-	const size_t size = translation_unit_get_size(nd);
-	for (size_t i = 0; i < size; i++)
+	for (node decl = translation_unit_get_declaration(nd, 0); node_is_correct(&decl); decl = node_get_sibling(&decl))
 	{
-		const node decl = translation_unit_get_declaration(nd, i);
 		emit_declaration(enc, &decl);
 	}
 
@@ -3935,9 +3910,9 @@ DEFARR2:\n\
  */
 
 
-int encode_to_mips(const workspace *const ws, syntax *const sx)
+int encode_to_mips(const workspace *const ws, syntax *const sx, const layout *const lt)
 {
-	if (!ws_is_correct(ws) || sx == NULL)
+	if (!ws_is_correct(ws) || sx == NULL || lt == NULL)
 	{
 		return -1;
 	}
@@ -3953,6 +3928,7 @@ int encode_to_mips(const workspace *const ws, syntax *const sx)
 	enc.global_displ = 0;
 
 	enc.displacements = hash_create(HASH_TABLE_SIZE);
+	enc.layout = lt;
 
 	for (size_t i = 0; i < TEMP_REG_AMOUNT + TEMP_FP_REG_AMOUNT; i++)
 	{
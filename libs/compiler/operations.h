@@ -159,63 +159,63 @@ typedef enum OPERATION
 typedef enum builtin
 {
 	// Diagnostics functions
-	BI_ASSERT				= 2,
+	BI_ASSERT				= 1,
 
 	// Math functions
-	BI_ASIN					= 6,
-	BI_COS					= 10,
-	BI_SIN					= 14,
-	BI_EXP					= 18,
-	BI_LOG					= 22,
-	BI_LOG10				= 26,
-	BI_SQRT					= 30,
-	BI_RAND					= 34,
-	BI_ROUND				= 38,
+	BI_ASIN					= 2,
+	BI_COS					= 3,
+	BI_SIN					= 4,
+	BI_EXP					= 5,
+	BI_LOG					= 6,
+	BI_LOG10				= 7,
+	BI_SQRT					= 8,
+	BI_RAND					= 9,
+	BI_ROUND				= 10,
 
 	// String functions
-	BI_STRNCPY				= 42,
-	BI_STRCAT				= 46,
-	BI_STRCMP				= 50,
-	BI_STRNCMP				= 54,
-	BI_STRSTR				= 58,
+	BI_STRNCPY				= 11,
+	BI_STRCAT				= 12,
+	BI_STRCMP				= 13,
+	BI_STRNCMP				= 14,
+	BI_STRSTR				= 15,
 
 	// Robot functions
-	BI_ROBOT_SEND_INT		= 62,
-	BI_ROBOT_SEND_FLOAT		= 66,
-	BI_ROBOT_SEND_STRING	= 70,
-	BI_ROBOT_RECEIVE_INT	= 74,
-	BI_ROBOT_RECEIVE_FLOAT	= 78,
-	BI_ROBOT_RECEIVE_STRING	= 82,
+	BI_ROBOT_SEND_INT		= 16,
+	BI_ROBOT_SEND_FLOAT		= 17,
+	BI_ROBOT_SEND_STRING	= 18,
+	BI_ROBOT_RECEIVE_INT	= 19,
+	BI_ROBOT_RECEIVE_FLOAT	= 20,
+	BI_ROBOT_RECEIVE_STRING	= 21,
 
 	// Thread functions
-	BI_T_CREATE				= 86,
-	BI_T_GETNUM				= 90,
-	BI_T_SLEEP				= 94,
-	BI_T_JOIN				= 98,
-	BI_T_EXIT				= 102,
-	BI_T_INIT				= 106,
-	BI_T_DESTROY			= 110,
+	BI_T_CREATE				= 22,
+	BI_T_GETNUM				= 23,
+	BI_T_SLEEP				= 24,
+	BI_T_JOIN				= 25,
+	BI_T_EXIT				= 26,
+	BI_T_INIT				= 27,
+	BI_T_DESTROY			= 28,
 
-	BI_SEM_CREATE			= 114,
-	BI_SEM_WAIT				= 118,
-	BI_SEM_POST				= 122,
+	BI_SEM_CREATE			= 29,
+	BI_SEM_WAIT				= 30,
+	BI_SEM_POST				= 31,
 
-	BI_MSG_SEND				= 126,
-	BI_MSG_RECEIVE			= 130,
+	BI_MSG_SEND				= 32,
+	BI_MSG_RECEIVE			= 33,
 
-	BI_FOPEN				= 134,
-	BI_FGETC				= 138,
-	BI_FPUTC				= 142,
-	BI_FCLOSE				= 146,
+	BI_FOPEN				= 34,
+	BI_FGETC				= 35,
+	BI_FPUTC				= 36,
+	BI_FCLOSE				= 37,
 
-	BI_EXIT					= 150,
+	BI_EXIT					= 38,
 
-	BI_PRINTF				= 154,
-	BI_PRINT				= 158,
-	BI_PRINTID				= 162,
-	BI_GETID				= 166,
+	BI_PRINTF				= 39,
+	BI_PRINT				= 40,
+	BI_PRINTID				= 41,
+	BI_GETID				= 42,
 
-	BEGIN_USER_FUNC			= 170,
+	BEGIN_USER_FUNC			= 43,
 } builtin_t;
 
 
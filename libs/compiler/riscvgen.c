@@ -17,6 +17,7 @@
 #include "riscvgen.h"
 #include "AST.h"
 #include "hash.h"
+#include "layout.h"
 #include "operations.h"
 #include "tree.h"
 #include "uniprinter.h"
@@ -31,7 +32,7 @@ static const size_t BUFFER_SIZE = 65536; /**< Размер буфера для 
 static const size_t HASH_TABLE_SIZE = 1024; /**< Размер хеш-таблицы для смещений и регистров */
 static const bool IS_ON_STACK = true; /**< Хранится ли переменная на стеке */
 
-static const size_t WORD_LENGTH = 4;	  /**< Длина слова данных */
+static const size_t WORD_LENGTH = RISCV_WORD_SIZE;	  /**< Длина слова данных */
 static const size_t HALF_WORD_LENGTH = 2; /**< Длина половины слова данных */
 
 static const size_t LOW_DYN_BORDER = 0x10010000; /**< Нижняя граница динамической памяти */
@@ -67,7 +68,9 @@ bool emit_literal = true;
 
 bool null_registers = false;
 
-int link_on_true_location[1000];
+// Глобальные переменные имеют положительное смещение, поэтому таблицы индексируются в обе стороны
+static int link_on_true_location_table[2 * 1000];
+static int *const link_on_true_location = &link_on_true_location_table[1000];
 
 int prev_size = 1;
 int prev_declaration_size = 1;
@@ -331,6 +334,7 @@ typedef struct encoder
 							@c key		- ссылка на таблицу идентификаторов
 							@c value[0]	- флаг, лежит ли переменная на стеке или в регистре
 							@c value[1]	- смещение или номер регистра */
+	const layout *layout;		/**< Размеры и смещения типов */
 
 	riscv_register_t next_register; /**< Следующий обычный регистр для выделения */
 	riscv_register_t next_float_register; /**< Следующий регистр с плавающей точкой для выделения */
@@ -366,25 +370,6 @@ static void emit_structure_init(encoder *const enc, const lvalue *const target,
 static void emit_statement(encoder *const enc, const node *const nd);
 
 
-static size_t riscv_type_size(const syntax *const sx, const item_t type)
-{
-	if (type_is_structure(sx, type))
-	{
-		size_t size = 0;
-		const size_t amount = type_structure_get_member_amount(sx, type);
-		for (size_t i = 0; i < amount; i++)
-		{
-			const item_t member_type = type_structure_get_member_type(sx, type, i);
-			size += riscv_type_size(sx, member_type);
-		}
-		return size;
-	}
-	else
-	{
-		return (type_is_floating(sx, type) ? 2 : 1) * WORD_LENGTH;
-	}
-}
-
 /**
  *	Locks certain register
  *
@@ -615,204 +600,204 @@ static void riscv_register_to_io(universal_io *const io, const riscv_register_t
 	switch (reg)
 	{
 		case R_ZERO:
-			uni_printf(io, "x0");
+			uni_print_str(io, "x0");
 			break;
 
 		case R_A0:
-			uni_printf(io, "a0");
+			uni_print_str(io, "a0");
 			break;
 		case R_A1:
-			uni_printf(io, "a1");
+			uni_print_str(io, "a1");
 			break;
 		case R_A2:
-			uni_printf(io, "a2");
+			uni_print_str(io, "a2");
 			break;
 		case R_A3:
-			uni_printf(io, "a3");
+			uni_print_str(io, "a3");
 			break;
 		case R_A4:
-			uni_printf(io, "a4");
+			uni_print_str(io, "a4");
 			break;
 		case R_A5:
-			uni_printf(io, "a5");
+			uni_print_str(io, "a5");
 			break;
 		case R_A6:
-			uni_printf(io, "a6");
+			uni_print_str(io, "a6");
 			break;
 		case R_A7:
-			uni_printf(io, "a7");
+			uni_print_str(io, "a7");
 			break;
 		case R_T0:
-			uni_printf(io, "t0");
+			uni_print_str(io, "t0");
 			break;
 		case R_T1:
-			uni_printf(io, "t1");
+			uni_print_str(io, "t1");
 			break;
 		case R_T2:
-			uni_printf(io, "t2");
+			uni_print_str(io, "t2");
 			break;
 		case R_T3:
-			uni_printf(io, "t3");
+			uni_print_str(io, "t3");
 			break;
 		case R_T4:
-			uni_printf(io, "t4");
+			uni_print_str(io, "t4");
 			break;
 		case R_T5:
-			uni_printf(io, "t5");
+			uni_print_str(io, "t5");
 			break;
 		case R_T6:
-			uni_printf(io, "t6");
+			uni_print_str(io, "t6");
 			break;
 
 		case R_S0:
-			uni_printf(io, "s0");
+			uni_print_str(io, "s0");
 			break;
 		case R_S1:
-			uni_printf(io, "s1");
+			uni_print_str(io, "s1");
 			break;
 		case R_S2:
-			uni_printf(io, "s2");
+			uni_print_str(io, "s2");
 			break;
 		case R_S3:
-			uni_printf(io, "s3");
+			uni_print_str(io, "s3");
 			break;
 		case R_S4:
-			uni_printf(io, "s4");
+			uni_print_str(io, "s4");
 			break;
 		case R_S5:
-			uni_printf(io, "s5");
+			uni_print_str(io, "s5");
 			break;
 		case R_S6:
-			uni_printf(io, "s6");
+			uni_print_str(io, "s6");
 			break;
 		case R_S7:
-			uni_printf(io, "s7");
+			uni_print_str(io, "s7");
 			break;
 		case R_S8:
-			uni_printf(io, "s8");
+			uni_print_str(io, "s8");
 			break;
 		case R_S9:
-			uni_printf(io, "s9");
+			uni_print_str(io, "s9");
 			break;
 		case R_S10:
-			uni_printf(io, "s10");
+			uni_print_str(io, "s10");
 			break;
 		case R_S11:
-			uni_printf(io, "s11");
+			uni_print_str(io, "s11");
 			break;
 
 		case R_GP:
-			uni_printf(io, "gp");
+			uni_print_str(io, "gp");
 			break;
 		case R_SP:
-			uni_printf(io, "sp");
+			uni_print_str(io, "sp");
 			break;
 		case R_FP:
-			uni_printf(io, "fp");
+			uni_print_str(io, "fp");
 			break;
 		case R_RA:
-			uni_printf(io, "ra");
+			uni_print_str(io, "ra");
 			break;
 
 		case R_FT0:
-			uni_printf(io, "f0");
+			uni_print_str(io, "f0");
 			break;
 		case R_FT1:
-			uni_printf(io, "f1");
+			uni_print_str(io, "f1");
 			break;
 		case R_FT2:
-			uni_printf(io, "f2");
+			uni_print_str(io, "f2");
 			break;
 		case R_FT3:
-			uni_printf(io, "f3");
+			uni_print_str(io, "f3");
 			break;
 		case R_FT4:
-			uni_printf(io, "f4");
+			uni_print_str(io, "f4");
 			break;
 		case R_FT5:
-			uni_printf(io, "f5");
+			uni_print_str(io, "f5");
 			break;
 		case R_FT6:
-			uni_printf(io, "f6");
+			uni_print_str(io, "f6");
 			break;
 		case R_FT7:
-			uni_printf(io, "f7");
+			uni_print_str(io, "f7");
 			break;
 
 		case R_FS0:
-			uni_printf(io, "f8");
+			uni_print_str(io, "f8");
 			break;
 		case R_FS1:
-			uni_printf(io, "f9");
+			uni_print_str(io, "f9");
 			break;
 
 		case R_FA0:
-			uni_printf(io, "f10");
+			uni_print_str(io, "f10");
 			break;
 		case R_FA1:
-			uni_printf(io, "f11");
+			uni_print_str(io, "f11");
 			break;
 		case R_FA2:
-			uni_printf(io, "f12");
+			uni_print_str(io, "f12");
 			break;
 		case R_FA3:
-			uni_printf(io, "f13");
+			uni_print_str(io, "f13");
 			break;
 		case R_FA4:
-			uni_printf(io, "f14");
+			uni_print_str(io, "f14");
 			break;
 		case R_FA5:
-			uni_printf(io, "f15");
+			uni_print_str(io, "f15");
 			break;
 		case R_FA6:
-			uni_printf(io, "f16");
+			uni_print_str(io, "f16");
 			break;
 		case R_FA7:
-			uni_printf(io, "f17");
+			uni_print_str(io, "f17");
 			break;
 
 		case R_FS2:
-			uni_printf(io, "f18");
+			uni_print_str(io, "f18");
 			break;
 		case R_FS3:
-			uni_printf(io, "f19");
+			uni_print_str(io, "f19");
 			break;
 		case R_FS4:
-			uni_printf(io, "f20");
+			uni_print_str(io, "f20");
 			break;
 		case R_FS5:
-			uni_printf(io, "f21");
+			uni_print_str(io, "f21");
 			break;
 		case R_FS6:
-			uni_printf(io, "f22");
+			uni_print_str(io, "f22");
 			break;
 		case R_FS7:
-			uni_printf(io, "f23");
+			uni_print_str(io, "f23");
 			break;
 		case R_FS8:
-			uni_printf(io, "f24");
+			uni_print_str(io, "f24");
 			break;
 		case R_FS9:
-			uni_printf(io, "f25");
+			uni_print_str(io, "f25");
 			break;
 		case R_FS10:
-			uni_printf(io, "f26");
+			uni_print_str(io, "f26");
 			break;
 		case R_FS11:
-			uni_printf(io, "f27");
+			uni_print_str(io, "f27");
 			break;
 
 		case R_FT8:
-			uni_printf(io, "f28");
+			uni_print_str(io, "f28");
 			break;
 		case R_FT9:
-			uni_printf(io, "f29");
+			uni_print_str(io, "f29");
 			break;
 		case R_FT10:
-			uni_printf(io, "f30");
+			uni_print_str(io, "f30");
 			break;
 		case R_FT11:
-			uni_printf(io, "f31");
+			uni_print_str(io, "f31");
 			break;
 	}
 }
@@ -822,174 +807,174 @@ static void instruction_to_io(universal_io *const io, const riscv_instruction_t
 	switch (instruction)
 	{
 		case IC_RISCV_MOVE:
-			uni_printf(io, "mv");
+			uni_print_str(io, "mv");
 			break;
 		case IC_RISCV_LI:
-			uni_printf(io, "li");
+			uni_print_str(io, "li");
 			break;
 		case IC_RISCV_LA:
-			uni_printf(io, "la");
+			uni_print_str(io, "la");
 			break;
 		case IC_RISCV_NOT:
-			uni_printf(io, "not");
+			uni_print_str(io, "not");
 			break;
 
 		case IC_RISCV_ADDI:
-			uni_printf(io, "addi");
+			uni_print_str(io, "addi");
 			break;
 		case IC_RISCV_SLLI:
-			uni_printf(io, "slli");
+			uni_print_str(io, "slli");
 			break;
 		case IC_RISCV_SRAI:
-			uni_printf(io, "srai");
+			uni_print_str(io, "srai");
 			break;
 		case IC_RISCV_ANDI:
-			uni_printf(io, "andi");
+			uni_print_str(io, "andi");
 			break;
 		case IC_RISCV_XORI:
-			uni_printf(io, "xori");
+			uni_print_str(io, "xori");
 			break;
 		case IC_RISCV_ORI:
-			uni_printf(io, "ori");
+			uni_print_str(io, "ori");
 			break;
 
 		case IC_RISCV_ADD:
-			uni_printf(io, "add");
+			uni_print_str(io, "add");
 			break;
 		case IC_RISCV_SUB:
-			uni_printf(io, "sub");
+			uni_print_str(io, "sub");
 			break;
 		case IC_RISCV_MUL:
-			uni_printf(io, "mul");
+			uni_print_str(io, "mul");
 			break;
 		case IC_RISCV_DIV:
-			uni_printf(io, "div");
+			uni_print_str(io, "div");
 			break;
 		case IC_RISCV_REM:
-			uni_printf(io, "rem");
+			uni_print_str(io, "rem");
 			break;
 		case IC_RISCV_SLL:
-			uni_printf(io, "sll");
+			uni_print_str(io, "sll");
 			break;
 		case IC_RISCV_SRA:
-			uni_printf(io, "sra");
+			uni_print_str(io, "sra");
 			break;
 		case IC_RISCV_AND:
-			uni_printf(io, "and");
+			uni_print_str(io, "and");
 			break;
 		case IC_RISCV_XOR:
-			uni_printf(io, "xor");
+			uni_print_str(io, "xor");
 			break;
 		case IC_RISCV_OR:
-			uni_printf(io, "or");
+			uni_print_str(io, "or");
 			break;
 
 		case IC_RISCV_SW:
-			uni_printf(io, "sw");
+			uni_print_str(io, "sw");
 			break;
 		case IC_RISCV_LW:
-			uni_printf(io, "lw");
+			uni_print_str(io, "lw");
 			break;
 
 		case IC_RISCV_JR:
-			uni_printf(io, "jr");
+			uni_print_str(io, "jr");
 			break;
 		case IC_RISCV_JAL:
-			uni_printf(io, "jal");
+			uni_print_str(io, "jal");
 			break;
 		case IC_RISCV_J:
-			uni_printf(io, "j");
+			uni_print_char(io, 'j');
 			break;
 
 
 		case IC_RISCV_BLT:
-			uni_printf(io, "blt");
+			uni_print_str(io, "blt");
 			break;
 		case IC_RISCV_BGE:
-			uni_printf(io, "bge");
+			uni_print_str(io, "bge");
 			break;
 		case IC_RISCV_BEQ:
-			uni_printf(io, "beq");
+			uni_print_str(io, "beq");
 			break;
 		case IC_RISCV_BNE:
-			uni_printf(io, "bne");
+			uni_print_str(io, "bne");
 			break;
 		case IC_RISCV_FEQ:
-			uni_printf(io, "feq.d");
+			uni_print_str(io, "feq.d");
 			break;
 		case IC_RISCV_FLT:
-			uni_printf(io, "flt.d");
+			uni_print_str(io, "flt.d");
 			break;
 		case IC_RISCV_FLE:
-			uni_printf(io, "fle.d");
+			uni_print_str(io, "fle.d");
 			break;
 
 		case IC_RISCV_SLTIU:
-			uni_printf(io, "sltiu");
+			uni_print_str(io, "sltiu");
 			break;
 
 		case IC_RISCV_NOP:
-			uni_printf(io, "nop");
+			uni_print_str(io, "nop");
 			break;
 
 		case IC_RISCV_FADD:
-			uni_printf(io, "fadd.d");
+			uni_print_str(io, "fadd.d");
 			break;
 		case IC_RISCV_FSUB:
-			uni_printf(io, "fsub.d");
+			uni_print_str(io, "fsub.d");
 			break;
 		case IC_RISCV_FMUL:
-			uni_printf(io, "fmul.d");
+			uni_print_str(io, "fmul.d");
 			break;
 		case IC_RISCV_FDIV:
-			uni_printf(io, "fdiv.d");
+			uni_print_str(io, "fdiv.d");
 			break;
 		case IC_RISCV_FMVI:
-			uni_printf(io, "fmv.w.x");
+			uni_print_str(io, "fmv.w.x");
 			break;
 
 		case IC_RISCV_FABS:
-			uni_printf(io, "fabs.s");
+			uni_print_str(io, "fabs.s");
 			break;
 		case IC_RISCV_DABS:
-			uni_printf(io, "fabs.d");
+			uni_print_str(io, "fabs.d");
 			break;
 
 		// TODO: remove later
 		case IC_RISCV_ABS:
-			uni_printf(io, "abs");
+			uni_print_str(io, "abs");
 			break;
 
 		case IC_RISCV_FSD:
-			uni_printf(io, "fsd");
+			uni_print_str(io, "fsd");
 			break;
 		case IC_RISCV_FLD:
-			uni_printf(io, "fld");
+			uni_print_str(io, "fld");
 			break;
 
 		case IC_RISCV_FMOV:
-			uni_printf(io, "mov");
+			uni_print_str(io, "mov");
 			break;
 
 		case IC_RISCV_MFC_1:
-			uni_printf(io, "mfc1");
+			uni_print_str(io, "mfc1");
 			break;
 		case IC_RISCV_MFHC_1:
-			uni_printf(io, "mfhc1");
+			uni_print_str(io, "mfhc1");
 			break;
 
 		case IC_RISCV_CVT_D_S:
-			uni_printf(io, "cvt.d.s");
+			uni_print_str(io, "cvt.d.s");
 			break;
 		case IC_RISCV_CVT_S_W:
-			uni_printf(io, "cvt.s.w");
+			uni_print_str(io, "cvt.s.w");
 			break;
 		case IC_RISCV_CVT_W_S:
-			uni_printf(io, "cvt.w.s");
+			uni_print_str(io, "cvt.w.s");
 		case IC_RISCV_FMV_D_X:
-			uni_printf(io, "fmv.d.x");
+			uni_print_str(io, "fmv.d.x");
 		case IC_RISCV_FCVT_D_W:
-			uni_printf(io, "fcvt.d.w");
+			uni_print_str(io, "fcvt.d.w");
 			break;
 	}
 }
@@ -997,11 +982,11 @@ static void instruction_to_io(universal_io *const io, const riscv_instruction_t
 // Начало инструкции:	instr reg,
 static void to_code_begin(universal_io *const io, const riscv_instruction_t instruction, const riscv_register_t reg)
 {
-	uni_printf(io, "\t");
+	uni_print_char(io, '\t');
 	instruction_to_io(io, instruction);
-	uni_printf(io, " ");
+	uni_print_char(io, ' ');
 	riscv_register_to_io(io, reg);
-	uni_printf(io, ", ");
+	uni_print_str(io, ", ");
 }
 
 // Вид инструкции:	instr	fst_reg, snd_reg, thd_reg
@@ -1011,9 +996,9 @@ static void to_code_3R(universal_io *const io, const riscv_instruction_t instruc
 	// printf("here\n");
 	to_code_begin(io, instruction, fst_reg);
 	riscv_register_to_io(io, snd_reg);
-	uni_printf(io, ", ");
+	uni_print_str(io, ", ");
 	riscv_register_to_io(io, thd_reg);
-	uni_printf(io, "\n");
+	uni_print_char(io, '\n');
 }
 
 // Вид инструкции:	instr	fst_reg, snd_reg
@@ -1024,7 +1009,7 @@ static void to_code_2R(universal_io *const io, const riscv_instruction_t instruc
 	to_code_begin(io, instruction, fst_reg);
 	riscv_register_to_io(io, snd_reg);
 	// printf();
-	uni_printf(io, "\n");
+	uni_print_char(io, '\n');
 }
 
 // Вид инструкции:	instr	fst_reg, snd_reg, imm
@@ -1034,7 +1019,9 @@ static void to_code_2R_I(universal_io *const io, const riscv_instruction_t instr
 	// printf("here\n");
 	to_code_begin(io, instruction, fst_reg);
 	riscv_register_to_io(io, snd_reg);
-	uni_printf(io, ", %" PRIitem "\n", imm);
+	uni_print_str(io, ", ");
+	uni_print_item(io, imm);
+	uni_print_char(io, '\n');
 }
 
 // Вид инструкции:	instr	fst_reg, imm(snd_reg)
@@ -1043,9 +1030,10 @@ static void to_code_R_I_R(universal_io *const io, const riscv_instruction_t inst
 {
 	// printf("here\n");
 	to_code_begin(io, instruction, fst_reg);
-	uni_printf(io, "%" PRIitem "(", imm);
+	uni_print_item(io, imm);
+	uni_print_char(io, '(');
 	riscv_register_to_io(io, snd_reg);
-	uni_printf(io, ")\n");
+	uni_print_str(io, ")\n");
 }
 
 // Вид инструкции:	instr	reg, imm
@@ -1123,7 +1111,8 @@ static void rvalue_to_io(encoder *const enc, const rvalue *const rval)
  *	@param	lvalue				Lvalue
  */
 item_t displ_counter = 0;
-item_t true_loc[10000];
+static item_t true_loc_table[2 * 10000];
+static item_t *const true_loc = &true_loc_table[10000];
 static void lvalue_to_io(encoder *const enc, lvalue * value)
 {
 	if (value->kind == LVALUE_KIND_REGISTER)
@@ -1163,7 +1152,7 @@ static lvalue displacements_add(encoder *const enc, const size_t identifier, con
 	const item_t type = ident_get_type(enc->sx, identifier);
 	if (is_local && !is_register)
 	{
-		enc->scope_displ += riscv_type_size(enc->sx, type);
+		enc->scope_displ += layout_get_size(enc->layout, type);
 		enc->max_displ = max(enc->scope_displ, enc->max_displ);
 	}
 	const item_t location = is_local ? -(item_t)enc->scope_displ : (item_t)enc->global_displ;
@@ -1181,7 +1170,7 @@ static lvalue displacements_add(encoder *const enc, const size_t identifier, con
 
 	if (!is_local)
 	{
-		enc->global_displ += riscv_type_size(enc->sx, type);
+		enc->global_displ += layout_get_size(enc->layout, type);
 	}
 
 	return (lvalue){ .kind = is_register ? LVALUE_KIND_REGISTER : LVALUE_KIND_STACK,
@@ -1586,14 +1575,14 @@ static lvalue emit_subscript_lvalue(encoder *const enc, const node *const nd)
 	{
 		return (lvalue){ .kind = LVALUE_KIND_STACK,
 						 .base_reg = base_value.val.reg_num,
-						 .loc.displ = -(item_t)index_value.val.int_val * riscv_type_size(enc->sx, type),
+						 .loc.displ = -(item_t)index_value.val.int_val * layout_get_size(enc->layout, type),
 						 .type = type };
 	}
 
 	const rvalue type_size_value = { // Можно было бы сделать отдельным конструктором
 									 .from_lvalue = !FROM_LVALUE,
 									 .kind = RVALUE_KIND_CONST,
-									 .val.int_val = riscv_type_size(enc->sx, type),
+									 .val.int_val = layout_get_size(enc->layout, type),
 									 .type = TYPE_INTEGER
 	};
 	const rvalue offset = { .from_lvalue = !FROM_LVALUE,
@@ -1626,13 +1615,8 @@ static lvalue emit_member_lvalue(encoder *const enc, const node *const nd)
 	const bool is_arrow = expression_member_is_arrow(nd);
 	const item_t struct_type = is_arrow ? type_pointer_get_element_type(enc->sx, base_type) : base_type;
 
-	size_t member_displ = 0;
 	const size_t member_index = expression_member_get_member_index(nd);
-	for (size_t i = 0; i < member_index; i++)
-	{
-		const item_t member_type = type_structure_get_member_type(enc->sx, struct_type, i);
-		member_displ += riscv_type_size(enc->sx, member_type);
-	}
+	const size_t member_displ = layout_get_member_offset(enc->layout, struct_type, member_index);
 
 	const item_t type = expression_get_type(nd);
 
@@ -3002,9 +2986,9 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 	size_t f_arg_counter = 0;
 	size_t arg_counter = 0;
 
-	for (size_t i = 0; i < params_amount; i++)
+	node arg = expression_call_get_argument(nd, 0);
+	for (size_t i = 0; i < params_amount; i++, arg = node_get_sibling(&arg))
 	{
-		const node arg = expression_call_get_argument(nd, i);
 		// транслируем аргумент, в объекте rvalue информация о его типе
 		// TODO: что если аргумент - структура, которая сохранена на стеке
 		// TODO: что если аргумент - структура или тип, который занимает несколько регистров?
@@ -3086,37 +3070,37 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 
 	const label label_func = { .kind = L_FUNC, .num = func_ref };
 	// выполняем прыжок в функцию по относительному смещению (метке)
-	if (label_func.num == 162)
+	if (label_func.num == BI_PRINTID)
 	{
 		emit_printid_expression(enc, nd);
 	}
-	else if (label_func.num == 158)
+	else if (label_func.num == BI_PRINT)
 	{
 		emit_print_expression(enc, nd);
 	}
-	else if (label_func.num == 46)
+	else if (label_func.num == BI_STRCAT)
 	{
 		emit_strcat_expression(enc, nd);
 	}
-	else if (label_func.num == 42)
+	else if (label_func.num == BI_STRNCPY)
 	{
 		emit_strncpy_expression(enc, nd);
 	}
-	else if (label_func.num != 154 && label_func.num != 6 && label_func.num != 10 && label_func.num != 14 &&
-		label_func.num != 18 && label_func.num != 22 && label_func.num != 26 && label_func.num != 30 &&
-		label_func.num != 46)
+	else if (label_func.num != BI_PRINTF && label_func.num != BI_ASIN && label_func.num != BI_COS && label_func.num != BI_SIN &&
+		label_func.num != BI_EXP && label_func.num != BI_LOG && label_func.num != BI_LOG10 && label_func.num != BI_SQRT &&
+		label_func.num != BI_STRCAT)
 	{
 		emit_unconditional_branch(enc, IC_RISCV_JAL, &label_func);
 	}
-	else if (label_func.num != 10 && label_func.num != 14 && label_func.num != 18 && label_func.num != 22 &&
-			 label_func.num != 26 && label_func.num != 30 && label_func.num != 46)
+	else if (label_func.num != BI_COS && label_func.num != BI_SIN && label_func.num != BI_EXP && label_func.num != BI_LOG &&
+			 label_func.num != BI_LOG10 && label_func.num != BI_SQRT && label_func.num != BI_STRCAT)
 	{
 		// uni_printf(enc->sx->io, "\t#$$$$$$$$$$$$$$$\n");
 		emit_printf_expression(enc, nd);
 		// uni_printf(enc->sx->io, "\t#&&&&&&&&&&&&&&\n");
 	}
 	uni_printf(enc->sx->io, "\n");
-	if (label_func.num == 6)
+	if (label_func.num == BI_ASIN)
 	{
 		uni_printf(enc->sx->io, "\tfmv.x.d a0, f0\n");
 		uni_printf(enc->sx->io, "\tfmv.d.x fa0, a0 \n");
@@ -3127,7 +3111,7 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 		// emit_store_of_rvalue(enc, &saved_f0_lvalue, );
 	}
 
-	if (label_func.num == 10) {
+	if (label_func.num == BI_COS) {
 		uni_printf(enc->sx->io, "\tfmv.x.d a0, f0\n");
 		uni_printf(enc->sx->io, "\tfmv.d.x fa0, a0 \n");
 		uni_printf(enc->sx->io, "\tcall    cos\n");
@@ -3137,7 +3121,7 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 		//emit_store_of_rvalue(enc, &saved_f0_lvalue, );
 	}
 
-	if (label_func.num == 14)
+	if (label_func.num == BI_SIN)
 	{
 		uni_printf(enc->sx->io, "\tfmv.x.d a0, f0\n");
 		uni_printf(enc->sx->io, "\tfmv.d.x fa0, a0 \n");
@@ -3148,7 +3132,7 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 		// emit_store_of_rvalue(enc, &saved_f0_lvalue, );
 	}
 
-	if (label_func.num == 18)
+	if (label_func.num == BI_EXP)
 	{
 		uni_printf(enc->sx->io, "\tfmv.x.d a0, f0\n");
 		uni_printf(enc->sx->io, "\tfmv.d.x fa0, a0 \n");
@@ -3159,7 +3143,7 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 		// emit_store_of_rvalue(enc, &saved_f0_lvalue, );
 	}
 
-	if (label_func.num == 22)
+	if (label_func.num == BI_LOG)
 	{
 		uni_printf(enc->sx->io, "\tfmv.x.d a0, f0\n");
 		uni_printf(enc->sx->io, "\tfmv.d.x fa0, a0 \n");
@@ -3170,7 +3154,7 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 		// emit_store_of_rvalue(enc, &saved_f0_lvalue, );
 	}
 
-	if (label_func.num == 26)
+	if (label_func.num == BI_LOG10)
 	{
 		uni_printf(enc->sx->io, "\tfmv.x.d a0, f0\n");
 		uni_printf(enc->sx->io, "\tfmv.d.x fa0, a0 \n");
@@ -3181,7 +3165,7 @@ static rvalue emit_call_expression(encoder *const enc, const node *const nd)
 		// emit_store_of_rvalue(enc, &saved_f0_lvalue, );
 	}
 
-	if (label_func.num == 30)
+	if (label_func.num == BI_SQRT)
 	{
 		uni_printf(enc->sx->io, "\tfmv.x.d a0, f0\n");
 		uni_printf(enc->sx->io, "\tfmv.d.x fa0, a0 \n");
@@ -3608,7 +3592,7 @@ static rvalue emit_struct_assignment(encoder *const enc, const lvalue *const tar
 
 		// Копирование всех данных из RHS
 		const item_t type = expression_get_type(value);
-		const size_t struct_size = riscv_type_size(enc->sx, type);
+		const size_t struct_size = layout_get_size(enc->layout, type);
 		for (size_t i = 0; i < struct_size; i += WORD_LENGTH)
 		{
 			// Грузим данные из RHS
@@ -3973,7 +3957,6 @@ static rvalue emit_bound(encoder *const enc, const node *const bound, const node
 //int prev_size = 1;
 //int prev_declaration_size = 1;
 
-int link_on_true_location[1000];
 static void emit_array_declaration(encoder *const enc, const node *const nd)
 {
 	//printf("\n%i\n", nd->index);
@@ -4131,7 +4114,7 @@ static void emit_structure_init(encoder *const enc, const lvalue *const target,
 		const lvalue member_lvalue = {
 			.base_reg = target->base_reg, .kind = target->kind, .loc.displ = target->loc.displ + displ, .type = type
 		};
-		displ += riscv_type_size(enc->sx, type);
+		displ += layout_get_size(enc->layout, type);
 
 		const node subexpr = expression_initializer_get_subexpr(initializer, i);
 		if (expression_get_class(&subexpr) == EXPR_INITIALIZER)
@@ -4402,10 +4385,8 @@ static void emit_declaration(encoder *const enc, const node *const nd)
  */
 static void emit_declaration_statement(encoder *const enc, const node *const nd)
 {
-	const size_t size = statement_declaration_get_size(nd);
-	for (size_t i = 0; i < size; i++)
+	for (node decl = statement_declaration_get_declarator(nd, 0); node_is_correct(&decl); decl = node_get_sibling(&decl))
 	{
-		const node decl = statement_declaration_get_declarator(nd, i);
 		emit_declaration(enc, &decl);
 	}
 }
@@ -4455,10 +4436,8 @@ static void emit_compound_statement(encoder *const enc, const node *const nd)
 {
 	const size_t scope_displacement = enc->scope_displ;
 
-	const size_t size = statement_compound_get_size(nd);
-	for (size_t i = 0; i < size; i++)
+	for (node substmt = statement_compound_get_substmt(nd, 0); node_is_correct(&substmt); substmt = node_get_sibling(&substmt))
 	{
-		const node substmt = statement_compound_get_substmt(nd, i);
 		emit_statement(enc, &substmt);
 	}
 
@@ -4549,10 +4528,8 @@ static void emit_switch_statement_old(encoder *const enc, const node *const nd)
 	// Размещение меток согласно условиям
 	const node body = statement_switch_get_body(nd);
 	// printf("%zx\n", body.tree->size);
-	const size_t amount = statement_compound_get_size(&body); // Гарантируется compound statement
-	for (size_t i = 0; i < amount; i++)
+	for (node substmt = statement_compound_get_substmt(&body, 0); node_is_correct(&substmt); substmt = node_get_sibling(&substmt))
 	{
-		const node substmt = statement_compound_get_substmt(&body, i);
 		const item_t substmt_class = statement_get_class(&substmt);
 
 		if (substmt_class == STMT_CASE)
@@ -4606,9 +4583,8 @@ static void emit_switch_statement_old(encoder *const enc, const node *const nd)
 	uni_printf(enc->sx->io, "\n");
 
 	// Размещение тел всех case и default statements
-	for (size_t i = 0; i < amount; i++)
+	for (node substmt = statement_compound_get_substmt(&body, 0); node_is_correct(&substmt); substmt = node_get_sibling(&substmt))
 	{
-		const node substmt = statement_compound_get_substmt(&body, i);
 		const item_t substmt_class = statement_get_class(&substmt);
 
 		if (substmt_class == STMT_CASE)
@@ -4658,15 +4634,12 @@ static void emit_switch_statement(encoder *const enc, const node *const nd)
 	item_t default_index = -1;
 
 	const node body = statement_switch_get_body(nd);
-	const size_t amount = statement_compound_get_size(&body);
 
 	//const rvalue case_expr_rvalue_tmp = emit_literal_expression(enc, &case_expr);
 	int case_amount = 0;
 
-	for (size_t i = 0; i < amount; i++)
+	for (node substmt = statement_compound_get_substmt(&body, 0); node_is_correct(&substmt); substmt = node_get_sibling(&substmt))
 	{
-		//printf("%zu", i);
-		const node substmt = statement_compound_get_substmt(&body, i);
 		const item_t substmt_class = statement_get_class(&substmt);
 		if (substmt_class == STMT_CASE)
 		{
@@ -4684,9 +4657,8 @@ static void emit_switch_statement(encoder *const enc, const node *const nd)
 	"\tmv t1, a0\n");
 
 	int case_counter_temp = 0;
-	for (size_t i = 0; i < amount; i++)
+	for (node substmt = statement_compound_get_substmt(&body, 0); node_is_correct(&substmt); substmt = node_get_sibling(&substmt))
 	{
-		const node substmt = statement_compound_get_substmt(&body, i);
 		const item_t substmt_class = statement_get_class(&substmt);
 
 		if (substmt_class == STMT_CASE)
@@ -4740,9 +4712,8 @@ static void emit_switch_statement(encoder *const enc, const node *const nd)
 
 
 	int case_counter = 0;
-	for (size_t i = 0; i < amount; i++)
+	for (node substmt = statement_compound_get_substmt(&body, 0); node_is_correct(&substmt); substmt = node_get_sibling(&substmt))
 	{
-		const node substmt = statement_compound_get_substmt(&body, i);
 		const item_t substmt_class = statement_get_class(&substmt);
 
 		if (substmt_class == STMT_CASE)
@@ -5068,10 +5039,8 @@ static void emit_statement(encoder *const enc, const node *const nd)
  */
 static int emit_translation_unit(encoder *const enc, const node *const nd)
 {
-	const size_t size = translation_unit_get_size(nd);
-	for (size_t i = 0; i < size; i++)
+	for (node decl = translation_unit_get_declaration(nd, 0); node_is_correct(&decl); decl = node_get_sibling(&decl))
 	{
-		const node decl = translation_unit_get_declaration(nd, i);
 		emit_declaration(enc, &decl);
 	}
 
@@ -5300,9 +5269,9 @@ StringArray *createStringArray()
 	return array;
 }
 
-int encode_to_riscv(const workspace *const ws, syntax *const sx)
+int encode_to_riscv(const workspace *const ws, syntax *const sx, const layout *const lt)
 {
-	if (!ws_is_correct(ws) || sx == NULL)
+	if (!ws_is_correct(ws) || sx == NULL || lt == NULL)
 	{
 		return -1;
 	}
@@ -5318,6 +5287,7 @@ int encode_to_riscv(const workspace *const ws, syntax *const sx)
 	enc.global_displ = 0;
 
 	enc.displacements = hash_create(HASH_TABLE_SIZE);
+	enc.layout = lt;
 
 	for (size_t i = 0; i < TEMP_REG_AMOUNT + TEMP_FP_REG_AMOUNT; i++)
 	{
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "layout.h"
 #include "syntax.h"
 #include "workspace.h"
 #include <string.h>
@@ -24,15 +25,23 @@
 extern "C" {
 #endif
 
+/** Size of non-floating scalar types on RISC-V */
+#define RISCV_WORD_SIZE 4
+
+/** Size of floating types on RISC-V */
+#define RISCV_FLOATING_SIZE 8
+
+
 /**
  *	Encode to mips codes
  *
  *	@param	ws				Compiler workspace
  *	@param	sx				Syntax structure
+ *	@param	lt				Type layout of target
  *
  *	@return	@c 0 on success, @c -1 on failure
  */
-int encode_to_riscv(const workspace *const ws, syntax *const sx);
+int encode_to_riscv(const workspace *const ws, syntax *const sx, const layout *const lt);
 
 #ifdef __cplusplus
 } /* extern "C" */
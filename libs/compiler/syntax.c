@@ -15,8 +15,11 @@
  */
 
 #include "syntax.h"
+#include <assert.h>
 #include <stdlib.h>
 #include <string.h>
+#include "keywords.h"
+#include "operations.h"
 #include "token.h"
 #include "tree.h"
 
@@ -26,210 +29,202 @@ static const size_t IDENTIFIERS_SIZE = 10000;
 static const size_t FUNCTIONS_SIZE = 100;
 static const size_t STRINGS_SIZE = 80;
 static const size_t TYPES_SIZE = 1000;
+static const size_t TYPE_INDEX_SIZE = 256;
+static const size_t MEMBER_INDEX_SIZE = 256;
 static const size_t TREE_SIZE = 10000;
 
 
-static void repr_add_keyword(map *const reprtab, const char32_t *const eng, const char32_t *const rus, const token_t token)
+/**	Get size of type record by its index */
+static inline size_t type_get_record_size(const syntax *const sx, const size_t type)
 {
-	char32_t buffer[MAX_STRING_LENGTH];
+	const item_t tag = vector_at(&sx->types, type);
+	return tag == TYPE_STRUCTURE || tag == TYPE_FUNCTION ? 3 + (size_t)vector_at(&sx->types, type + 2) : 2;
+}
 
-	buffer[0] = utf8_to_upper(eng[0]);
-	for (size_t i = 1; eng[i - 1] != '\0'; i++)
+/**	Get hash of type record */
+static inline size_t type_get_hash(const item_t *const record, const size_t size)
+{
+	size_t hash = size;
+	for (size_t i = 0; i < size; i++)
 	{
-		buffer[i] = utf8_to_upper(eng[i]);
+		hash = (hash ^ (size_t)record[i]) * 0x01000193;
+		hash ^= hash >> 15;
 	}
-	map_add_by_utf8(reprtab, eng, token);
-	map_add_by_utf8(reprtab, buffer, token);
 
-	buffer[0] = utf8_to_upper(rus[0]);
-	for (size_t i = 1; rus[i - 1] != '\0'; i++)
+	return hash;
+}
+
+/**	Find type record in hash index, returns slot of type or empty slot for new type */
+static size_t type_index_search(const syntax *const sx, const item_t *const record, const size_t size)
+{
+	const size_t mask = vector_size(&sx->type_index) - 1;
+	for (size_t slot = type_get_hash(record, size) & mask; ; slot = (slot + 1) & mask)
 	{
-		buffer[i] = utf8_to_upper(rus[i]);
+		const size_t type = (size_t)vector_at(&sx->type_index, slot);
+		if (type == 0)
+		{
+			return slot;
+		}
+
+		if (type_get_record_size(sx, type) == size
+			&& memcmp(&sx->types.array[type], record, size * sizeof(item_t)) == 0)
+		{
+			return slot;
+		}
 	}
-	map_add_by_utf8(reprtab, rus, token);
-	map_add_by_utf8(reprtab, buffer, token);
 }
 
-static inline void repr_init(map *const reprtab)
+/**	Add type record to hash index */
+static void type_index_add(syntax *const sx, const size_t type)
 {
-	repr_add_keyword(reprtab, U"#line", U"#строка", TK_LINE);
+	const size_t capacity = vector_size(&sx->type_index);
+	if (2 * (sx->type_amount + 1) > capacity)
+	{
+		// Заполнено больше половины - перестраиваем индекс с удвоенной ёмкостью
+		vector old = sx->type_index;
+		sx->type_index = vector_create_in(sx->region, 2 * capacity);
+		vector_increase(&sx->type_index, 2 * capacity);
+		sx->type_amount = 0;
 
-	repr_add_keyword(reprtab, U"main", U"главная", TK_MAIN);
-	repr_add_keyword(reprtab, U"char", U"литера", TK_CHAR);
-	repr_add_keyword(reprtab, U"double", U"двойной", TK_DOUBLE);
-	repr_add_keyword(reprtab, U"float", U"вещ", TK_FLOAT);
-	repr_add_keyword(reprtab, U"int", U"цел", TK_INT);
-	repr_add_keyword(reprtab, U"long", U"длин", TK_LONG);
-	repr_add_keyword(reprtab, U"struct", U"структура", TK_STRUCT);
-	repr_add_keyword(reprtab, U"enum", U"перечисление", TK_ENUM);
-	repr_add_keyword(reprtab, U"void", U"пусто", TK_VOID);
-	repr_add_keyword(reprtab, U"file", U"файл", TK_FILE);
-	repr_add_keyword(reprtab, U"typedef", U"типопр", TK_TYPEDEF);
-	repr_add_keyword(reprtab, U"if", U"если", TK_IF);
-	repr_add_keyword(reprtab, U"else", U"иначе", TK_ELSE);
-	repr_add_keyword(reprtab, U"do", U"цикл", TK_DO);
-	repr_add_keyword(reprtab, U"while", U"пока", TK_WHILE);
-	repr_add_keyword(reprtab, U"for", U"для", TK_FOR);
-	repr_add_keyword(reprtab, U"switch", U"выбор", TK_SWITCH);
-	repr_add_keyword(reprtab, U"case", U"случай", TK_CASE);
-	repr_add_keyword(reprtab, U"default", U"умолчание", TK_DEFAULT);
-	repr_add_keyword(reprtab, U"break", U"выход", TK_BREAK);
-	repr_add_keyword(reprtab, U"continue", U"продолжить", TK_CONTINUE);
-	repr_add_keyword(reprtab, U"return", U"возврат", TK_RETURN);
-	repr_add_keyword(reprtab, U"null", U"ничто", TK_NULL);
-	repr_add_keyword(reprtab, U"abs", U"абс", TK_ABS);
-	repr_add_keyword(reprtab, U"upb", U"кол_во", TK_UPB);
-	repr_add_keyword(reprtab, U"bool", U"булево", TK_BOOL);
-	repr_add_keyword(reprtab, U"true", U"истина", TK_TRUE);
-	repr_add_keyword(reprtab, U"false", U"ложь", TK_FALSE);
-	repr_add_keyword(reprtab, U"const", U"конст", TK_CONST);
-}
+		for (size_t i = 0; i < capacity; i++)
+		{
+			const size_t indexed = (size_t)vector_at(&old, i);
+			if (indexed != 0)
+			{
+				type_index_add(sx, indexed);
+			}
+		}
 
+		vector_clear(&old);
+	}
 
-static inline void type_init(syntax *const sx)
-{
-	vector_increase(&sx->types, 1);
-	// занесение в types описателя struct {int numTh; int inf; }
-	sx->start_type = vector_add(&sx->types, 0);
-	vector_add(&sx->types, TYPE_STRUCTURE);
-	vector_add(&sx->types, 2);
-	vector_add(&sx->types, 4);
-	vector_add(&sx->types, TYPE_INTEGER);
-	vector_add(&sx->types, (item_t)map_reserve(&sx->representations, "numTh"));
-	vector_add(&sx->types, TYPE_INTEGER);
-	vector_add(&sx->types, (item_t)map_reserve(&sx->representations, "data"));
+	const size_t size = type_get_record_size(sx, type);
+	const size_t slot = type_index_search(sx, &sx->types.array[type], size);
+	*vector_at_mut(&sx->type_index, slot) = (item_t)type;
+	sx->type_amount++;
 }
 
-static inline item_t get_static(syntax *const sx, const item_t type)
+/**	Find structure member in hash index, returns slot of member or empty slot for new member */
+static size_t member_index_search(const syntax *const sx, const item_t type, const size_t name)
 {
-	const item_t old_displ = sx->displ;
-	sx->displ += sx->lg * (item_t)type_size(sx, type);
-
-	if (sx->lg > 0)
-	{
-		sx->max_displ = sx->displ > sx->max_displ ? sx->displ : sx->max_displ;
-	}
-	else
+	// Каждая запись индекса занимает три ячейки: тип структуры, имя члена и его номер
+	const size_t mask = vector_size(&sx->member_index) / 3 - 1;
+	const size_t hash = ((size_t)type * 0x9E3779B1) ^ (name * 0x01000193);
+	for (size_t slot = (hash ^ (hash >> 15)) & mask; ; slot = (slot + 1) & mask)
 	{
-		sx->max_displg = -sx->displ;
+		const item_t indexed = vector_at(&sx->member_index, 3 * slot);
+		if (indexed == 0 || (indexed == type && (size_t)vector_at(&sx->member_index, 3 * slot + 1) == name))
+		{
+			return slot;
+		}
 	}
-
-	return old_displ;
 }
 
-/**	Check if types are equal */
-static inline bool type_is_equal(const syntax *const sx, const size_t first, const size_t second)
+/**	Add structure member to hash index, the first of members with same name is kept */
+static void member_index_add(syntax *const sx, const item_t type, const size_t name, const size_t index)
 {
-	if (vector_get(&sx->types, first) != vector_get(&sx->types, second))
+	const size_t capacity = vector_size(&sx->member_index) / 3;
+	if (2 * (sx->member_amount + 1) > capacity)
 	{
-		return false;
-	}
+		// Заполнено больше половины - перестраиваем индекс с удвоенной ёмкостью
+		vector old = sx->member_index;
+		sx->member_index = vector_create_in(sx->region, 3 * 2 * capacity);
+		vector_increase(&sx->member_index, 3 * 2 * capacity);
+		sx->member_amount = 0;
 
-	size_t length = 1;
-	const item_t type = vector_get(&sx->types, first);
+		for (size_t i = 0; i < capacity; i++)
+		{
+			const item_t indexed = vector_at(&old, 3 * i);
+			if (indexed != 0)
+			{
+				member_index_add(sx, indexed, (size_t)vector_at(&old, 3 * i + 1), (size_t)vector_at(&old, 3 * i + 2));
+			}
+		}
 
-	if (type == TYPE_CONST)
-	{
-		return type_is_equal(sx, type_const_get_unqualified_type(sx, first), type_const_get_unqualified_type(sx, second));
+		vector_clear(&old);
 	}
 
-	// Определяем, сколько полей надо сравнивать для различных типов записей
-	if (type == TYPE_STRUCTURE || type == TYPE_FUNCTION)
+	const size_t slot = member_index_search(sx, type, name);
+	if (vector_at(&sx->member_index, 3 * slot) == 0)
 	{
-		length = 2 + (size_t)vector_get(&sx->types, first + 2);
+		vector_set(&sx->member_index, 3 * slot, type);
+		vector_set(&sx->member_index, 3 * slot + 1, (item_t)name);
+		vector_set(&sx->member_index, 3 * slot + 2, (item_t)index);
+		sx->member_amount++;
 	}
+}
 
-	for (size_t i = 1; i <= length; i++)
+/**	Add all members of structure type to hash index */
+static void member_index_add_structure(syntax *const sx, const item_t type)
+{
+	const size_t amount = type_structure_get_member_amount(sx, type);
+	for (size_t i = 0; i < amount; i++)
 	{
-		if (vector_get(&sx->types, first + i) != vector_get(&sx->types, second + i))
-		{
-			return false;
-		}
+		member_index_add(sx, type, type_structure_get_member_name(sx, type, i), i);
 	}
-
-	return true;
 }
 
-static void builtin_add(syntax *const sx, const char32_t *const eng, const char32_t *const rus, const item_t type)
+static inline void type_init(syntax *const sx)
 {
-	// Добавляем одно из написаний в таблицу representations
-	const size_t repr = map_add_by_utf8(&sx->representations, eng, ITEM_MAX);
+	vector_increase(&sx->types, 1);
+	// занесение в types описателя struct {int numTh; int inf; }
+	sx->start_type = vector_push_unchecked(&sx->types, 0);
+	vector_push_unchecked(&sx->types, TYPE_STRUCTURE);
+	vector_push_unchecked(&sx->types, 2);
+	vector_push_unchecked(&sx->types, 4);
+	vector_push_unchecked(&sx->types, TYPE_INTEGER);
+	vector_push_unchecked(&sx->types, (item_t)map_reserve(&sx->representations, "numTh"));
+	vector_push_unchecked(&sx->types, TYPE_INTEGER);
+	vector_push_unchecked(&sx->types, (item_t)map_reserve(&sx->representations, "data"));
 
-	// Добавляем идентификатор в identifiers
-	const item_t id = (item_t)ident_add(sx, repr, 2, type, 1);
+	type_index_add(sx, sx->start_type + 1);
+	member_index_add_structure(sx, (item_t)sx->start_type + 1);
+}
 
-	// Добавляем остальные варианты написания, все будут ссылаться на id
-	char32_t buffer[MAX_STRING_LENGTH];
+static inline item_t get_static(syntax *const sx, const item_t type)
+{
+	const item_t old_displ = sx->displ;
+	sx->displ += sx->lg * (item_t)type_size(sx, type);
 
-	buffer[0] = utf8_to_upper(eng[0]);
-	for (size_t i = 1; eng[i - 1] != '\0'; i++)
+	if (sx->lg > 0)
 	{
-		buffer[i] = utf8_to_upper(eng[i]);
+		sx->max_displ = sx->displ > sx->max_displ ? sx->displ : sx->max_displ;
 	}
-	map_add_by_utf8(&sx->representations, buffer, id);
-
-	buffer[0] = utf8_to_upper(rus[0]);
-	for (size_t i = 1; rus[i - 1] != '\0'; i++)
+	else
 	{
-		buffer[i] = utf8_to_upper(rus[i]);
+		sx->max_displg = -sx->displ;
 	}
-	map_add_by_utf8(&sx->representations, rus, id);
-	map_add_by_utf8(&sx->representations, buffer, id);
+
+	return old_displ;
 }
 
+/**	Increase size of all arrays of identifiers table */
+static inline void ident_table_increase(ident_table *const table, const size_t size)
+{
+	cell_vector_increase(&table->prevs, size);
+	cell_vector_increase(&table->reprs, size);
+	cell_vector_increase(&table->types, size);
+	cell_vector_increase(&table->displs, size);
+}
+
+static void builtin_add(syntax *const sx, const builtin_t id, const char32_t *const eng, const item_t type)
+{
+	// Остальные написания добавляются в таблицу representations при первом упоминании
+	const size_t repr = map_reserve_by_utf8(&sx->representations, eng);
+	const size_t last_id = ident_add(sx, repr, 2, type, 1);
+
+	assert(last_id == (size_t)id);
+	(void)last_id;
+	(void)id;
+}
 
 static void ident_init(syntax *const sx)
 {
-	builtin_add(sx, U"assert", U"проверить", type_function(sx, TYPE_VOID, "bs"));
-
-	builtin_add(sx, U"asin", U"асин", type_function(sx, TYPE_FLOATING, "f"));
-	builtin_add(sx, U"cos", U"кос", type_function(sx, TYPE_FLOATING, "f"));
-	builtin_add(sx, U"sin", U"син", type_function(sx, TYPE_FLOATING, "f"));
-	builtin_add(sx, U"exp", U"эксп", type_function(sx, TYPE_FLOATING, "f"));
-	builtin_add(sx, U"log", U"лог", type_function(sx, TYPE_FLOATING, "f"));
-	builtin_add(sx, U"log10", U"лог10", type_function(sx, TYPE_FLOATING, "f"));
-	builtin_add(sx, U"sqrt", U"квкор", type_function(sx, TYPE_FLOATING, "f"));
-	builtin_add(sx, U"rand", U"случ", type_function(sx, TYPE_FLOATING, ""));
-	builtin_add(sx, U"round", U"округл", type_function(sx, TYPE_INTEGER, "f"));
-
-	builtin_add(sx, U"strncpy", U"копир_н_симв", type_function(sx, type_string(sx), "si"));
-	builtin_add(sx, U"strcat", U"конкат_строки", type_function(sx, type_string(sx), "ss"));
-	builtin_add(sx, U"strcmp", U"сравн_строк", type_function(sx, TYPE_INTEGER, "ss"));
-	builtin_add(sx, U"strncmp", U"сравн_н_симв", type_function(sx, TYPE_INTEGER, "ssi"));
-	builtin_add(sx, U"strstr", U"нач_подстрок", type_function(sx, TYPE_INTEGER, "ss"));
-
-	builtin_add(sx, U"send_int_to_robot", U"послать_цел_на_робот", type_function(sx, TYPE_VOID, "iI"));
-	builtin_add(sx, U"send_float_to_robot", U"послать_вещ_на_робот", type_function(sx, TYPE_VOID, "iF"));
-	builtin_add(sx, U"send_string_to_robot", U"послать_строку_на_робот", type_function(sx, TYPE_VOID, "is"));
-	builtin_add(sx, U"receive_int_from_robot", U"получить_цел_от_робота", type_function(sx, TYPE_INTEGER, "i"));
-	builtin_add(sx, U"receive_float_from_robot", U"получить_вещ_от_робота", type_function(sx, TYPE_FLOATING, "i"));
-	builtin_add(sx, U"receive_string_from_robot", U"получить_строку_от_робота", type_function(sx, TYPE_VOID, "i"));
-
-	builtin_add(sx, U"t_create", U"н_создать", type_function(sx, TYPE_INTEGER, "T"));
-	builtin_add(sx, U"t_getnum", U"н_номер_нити", type_function(sx, TYPE_INTEGER, ""));
-	builtin_add(sx, U"t_sleep", U"н_спать", type_function(sx, TYPE_VOID, "i"));
-	builtin_add(sx, U"t_join", U"н_присоед", type_function(sx, TYPE_VOID, "i"));
-	builtin_add(sx, U"t_exit", U"н_конец", type_function(sx, TYPE_VOID, ""));
-	builtin_add(sx, U"t_init", U"н_начать", type_function(sx, TYPE_VOID, ""));
-	builtin_add(sx, U"t_destroy", U"н_закончить", type_function(sx, TYPE_VOID, ""));
-
-	builtin_add(sx, U"t_sem_create", U"н_создать_сем", type_function(sx, TYPE_INTEGER, "i"));
-	builtin_add(sx, U"t_sem_wait", U"н_вниз_сем", type_function(sx, TYPE_VOID, "i"));
-	builtin_add(sx, U"t_sem_post", U"н_вверх_сем", type_function(sx, TYPE_VOID, "i"));
-
-	builtin_add(sx, U"t_msg_send", U"н_послать", type_function(sx, TYPE_VOID, "m"));
-	builtin_add(sx, U"t_msg_receive", U"н_получить", type_function(sx, TYPE_MSG_INFO, ""));
-
-	builtin_add(sx, U"fopen", U"фоткрыть", type_function(sx, type_pointer(sx, TYPE_FILE), "ss"));
-	builtin_add(sx, U"fgetc", U"фчитать_символ", type_function(sx, TYPE_INTEGER, "P"));
-	builtin_add(sx, U"fputc", U"фписать_символ", type_function(sx, TYPE_INTEGER, "iP"));
-	builtin_add(sx, U"fclose", U"фзакрыть", type_function(sx, TYPE_INTEGER, "P"));
-	builtin_add(sx, U"exit", U"выход", type_function(sx, TYPE_VOID, "i"));
-
-	builtin_add(sx, U"printf", U"печатьф", type_function(sx, TYPE_INTEGER, "s."));
-	builtin_add(sx, U"print", U"печать", type_function(sx, TYPE_VOID, "."));
-	builtin_add(sx, U"printid", U"печатьид", type_function(sx, TYPE_VOID, "."));
-	builtin_add(sx, U"getid", U"читатьид", type_function(sx, TYPE_VOID, "."));
+	#define KEYWORD(token, eng, rus)
+	#define BUILTIN(identifier, eng, rus, type) builtin_add(sx, identifier, eng, type);
+	#include "keywords.def"
+	#undef KEYWORD
+	#undef BUILTIN
 }
 
 static item_t type_get(const syntax *const sx, const size_t index)
@@ -251,23 +246,33 @@ syntax sx_create(const workspace *const ws, universal_io *const io)
 {
 	syntax sx;
 	sx.io = io;
+	sx.region = arena_create(0);
 
-	sx.string_literals = strings_create(STRINGS_SIZE);
+	sx.string_literals = strings_create_in(sx.region, STRINGS_SIZE);
 
-	sx.predef = vector_create(FUNCTIONS_SIZE);
-	sx.functions = vector_create(FUNCTIONS_SIZE);
+	sx.predef = hash_create_in(sx.region, FUNCTIONS_SIZE);
+	sx.functions = vector_create_in(sx.region, FUNCTIONS_SIZE);
 	vector_increase(&sx.functions, 2);
 
-	sx.tree = vector_create(TREE_SIZE);
-
-	sx.identifiers = vector_create(IDENTIFIERS_SIZE);
-	vector_increase(&sx.identifiers, 2);
-	sx.cur_id = 2;
-
-	sx.representations = map_create(REPRESENTATIONS_SIZE);
-	repr_init(&sx.representations);
-
-	sx.types = vector_create(TYPES_SIZE);
+	sx.tree = node_tree_create_in(sx.region, TREE_SIZE);
+
+	// Нулевой идентификатор зарезервирован
+	sx.identifiers.prevs = cell_vector_create_in(sx.region, IDENTIFIERS_SIZE);
+	sx.identifiers.reprs = cell_vector_create_in(sx.region, IDENTIFIERS_SIZE);
+	sx.identifiers.types = cell_vector_create_in(sx.region, IDENTIFIERS_SIZE);
+	sx.identifiers.displs = cell_vector_create_in(sx.region, IDENTIFIERS_SIZE);
+	ident_table_increase(&sx.identifiers, 1);
+	sx.cur_id = 1;
+
+	sx.representations = map_create_in(sx.region, REPRESENTATIONS_SIZE);
+
+	sx.types = vector_create_in(sx.region, TYPES_SIZE);
+	sx.type_index = vector_create_in(sx.region, TYPE_INDEX_SIZE);
+	vector_increase(&sx.type_index, TYPE_INDEX_SIZE);
+	sx.type_amount = 0;
+	sx.member_index = vector_create_in(sx.region, 3 * MEMBER_INDEX_SIZE);
+	vector_increase(&sx.member_index, 3 * MEMBER_INDEX_SIZE);
+	sx.member_amount = 0;
 	type_init(&sx);
 
 	ident_init(&sx);
@@ -298,11 +303,14 @@ bool sx_is_correct(syntax *const sx)
 		was_error = true;
 	}
 
-	for (size_t i = 0; i < vector_size(&sx->predef); i++)
+	// Записи хеш-таблицы идут за заголовками цепочек в порядке добавления
+	const size_t predef_size = vector_size(&sx->predef);
+	for (size_t i = MAX_HASH; i < predef_size; i += 3 + hash_get_amount_by_index(&sx->predef, i))
 	{
-		if (vector_get(&sx->predef, i))
+		const item_t repr = hash_get_key(&sx->predef, i);
+		if (repr != ITEM_MAX)
 		{
-			system_error(predef_but_notdef, repr_get_name(sx, (size_t)vector_get(&sx->predef, i)));
+			system_error(predef_but_notdef, repr_get_name(sx, (size_t)repr));
 			was_error = true;
 		}
 	}
@@ -317,17 +325,30 @@ int sx_clear(syntax *const sx)
 		return -1;
 	}
 
+	// Блоки региона освобождаются вместе с ним, а без региона - по отдельности
 	strings_clear(&sx->string_literals);
 
-	vector_clear(&sx->predef);
+	hash_clear(&sx->predef);
 	vector_clear(&sx->functions);
 
-	vector_clear(&sx->tree);
+	node_tree_clear(&sx->tree);
+
+	cell_vector_clear(&sx->identifiers.prevs);
+	cell_vector_clear(&sx->identifiers.reprs);
+	cell_vector_clear(&sx->identifiers.types);
+	cell_vector_clear(&sx->identifiers.displs);
 
-	vector_clear(&sx->identifiers);
 	vector_clear(&sx->types);
+	vector_clear(&sx->type_index);
+	vector_clear(&sx->member_index);
 	map_clear(&sx->representations);
 
+	if (sx->region != NULL)
+	{
+		arena_clear(sx->region);
+		sx->region = NULL;
+	}
+
 	return 0;
 }
 
@@ -377,10 +398,10 @@ size_t func_reserve(syntax *const sx)
 
 size_t ident_add(syntax *const sx, const size_t repr, const item_t kind, const item_t type, const int func_def)
 {
-	const size_t last_id = vector_size(&sx->identifiers);
+	const size_t last_id = ident_get_amount(sx);
 	const item_t ref = repr_get_reference(sx, repr);
-	vector_add(&sx->identifiers, ref == ITEM_MAX ? ITEM_MAX - 1 : ref);
-	vector_increase(&sx->identifiers, 3);
+	ident_table_increase(&sx->identifiers, 1);
+	cell_vector_set(&sx->identifiers.prevs, last_id, cell_from_item(ref == ITEM_MAX ? ITEM_MAX - 1 : ref));
 
 	if (ref == 0) // это может быть только MAIN
 	{
@@ -443,18 +464,12 @@ size_t ident_add(syntax *const sx, const size_t repr, const item_t kind, const i
 		{
 			// Это предописание функции
 			ident_set_repr(sx, last_id, -ident_get_repr(sx, last_id));
-			vector_add(&sx->predef, (item_t)repr);
+			hash_add(&sx->predef, (item_t)repr, 0);
 		}
 		else
 		{
 			// Это описание функции
-			for (size_t i = 0; i < vector_size(&sx->predef); i++)
-			{
-				if ((size_t)vector_get(&sx->predef, i) == repr)
-				{
-					vector_set(&sx->predef, i, 0);
-				}
-			}
+			hash_remove(&sx->predef, (item_t)repr);
 		}
 	}
 	return last_id;
@@ -462,22 +477,22 @@ size_t ident_add(syntax *const sx, const size_t repr, const item_t kind, const i
 
 size_t ident_get_prev(const syntax *const sx, const size_t index)
 {
-	return sx != NULL ? (size_t)vector_get(&sx->identifiers, index) : SIZE_MAX;
+	return sx != NULL ? (size_t)cell_to_item(cell_vector_get(&sx->identifiers.prevs, index)) : SIZE_MAX;
 }
 
 item_t ident_get_repr(const syntax *const sx, const size_t index)
 {
-	return sx != NULL ? vector_get(&sx->identifiers, index + 1) : ITEM_MAX;
+	return sx != NULL ? cell_to_item(cell_vector_get(&sx->identifiers.reprs, index)) : ITEM_MAX;
 }
 
 item_t ident_get_type(const syntax *const sx, const size_t index)
 {
-	return sx != NULL ? vector_get(&sx->identifiers, index + 2) : ITEM_MAX;
+	return sx != NULL ? cell_to_item(cell_vector_get(&sx->identifiers.types, index)) : ITEM_MAX;
 }
 
 item_t ident_get_displ(const syntax *const sx, const size_t index)
 {
-	return sx != NULL ? vector_get(&sx->identifiers, index + 3) : ITEM_MAX;
+	return sx != NULL ? cell_to_item(cell_vector_get(&sx->identifiers.displs, index)) : ITEM_MAX;
 }
 
 const char *ident_get_spelling(const syntax *const sx, const size_t index)
@@ -487,17 +502,22 @@ const char *ident_get_spelling(const syntax *const sx, const size_t index)
 
 int ident_set_repr(syntax *const sx, const size_t index, const item_t repr)
 {
-	return sx != NULL ? vector_set(&sx->identifiers, index + 1, repr) : -1;
+	return sx != NULL ? cell_vector_set(&sx->identifiers.reprs, index, cell_from_item(repr)) : -1;
 }
 
 int ident_set_type(syntax *const sx, const size_t index, const item_t type)
 {
-	return sx != NULL ? vector_set(&sx->identifiers, index + 2, type) : -1;
+	return sx != NULL ? cell_vector_set(&sx->identifiers.types, index, cell_from_item(type)) : -1;
 }
 
 int ident_set_displ(syntax *const sx, const size_t index, const item_t displ)
 {
-	return sx != NULL ? vector_set(&sx->identifiers, index + 3, displ) : -1;
+	return sx != NULL ? cell_vector_set(&sx->identifiers.displs, index, cell_from_item(displ)) : -1;
+}
+
+size_t ident_get_amount(const syntax *const sx)
+{
+	return sx != NULL ? cell_vector_size(&sx->identifiers.reprs) : 0;
 }
 
 bool ident_is_type_specifier(syntax *const sx, const size_t index)
@@ -518,27 +538,27 @@ item_t type_add(syntax *const sx, const item_t *const record, const size_t size)
 		return ITEM_MAX;
 	}
 
-	sx->start_type = vector_add(&sx->types, (item_t)sx->start_type);
+	// Перечисления всегда различны, их поля дописываются после добавления
+	const bool is_enum = record[0] == TYPE_ENUM;
+	if (!is_enum)
+	{
+		const size_t slot = type_index_search(sx, record, size);
+		const size_t type = (size_t)vector_at(&sx->type_index, slot);
+		if (type != 0)
+		{
+			return (item_t)type;
+		}
+	}
+
+	sx->start_type = vector_push_unchecked(&sx->types, (item_t)sx->start_type);
 	for (size_t i = 0; i < size; i++)
 	{
-		vector_add(&sx->types, record[i]);
+		vector_push_unchecked(&sx->types, record[i]);
 	}
 
-	// Checking mode duplicates
-	size_t old = (size_t)vector_get(&sx->types, sx->start_type);
-	while (old)
+	if (!is_enum)
 	{
-		if (type_is_equal(sx, sx->start_type + 1, old + 1))
-		{
-			const size_t start_type = sx->start_type;
-			sx->start_type = (size_t)vector_get(&sx->types, sx->start_type);
-			vector_resize(&sx->types, start_type);
-			return (item_t)old + 1;
-		}
-		else
-		{
-			old = (size_t)vector_get(&sx->types, old);
-		}
+		type_index_add(sx, sx->start_type + 1);
 	}
 
 	return (item_t)sx->start_type + 1;
@@ -553,7 +573,7 @@ item_t type_enum_add_fields(syntax *const sx, const item_t *const record, const
 
 	for (size_t i = 0; i < size; i++)
 	{
-		vector_add(&sx->types, record[i]);
+		vector_push_unchecked(&sx->types, record[i]);
 	}
 
 	return (item_t)sx->start_type + 1;
@@ -721,25 +741,35 @@ item_t type_array_get_element_type(const syntax *const sx, const item_t type)
 
 item_t type_structure(syntax *const sx, vector *const types, vector *const names)
 {
-	item_t local_modetab[100];
-	size_t local_md = 3;
-
 	const size_t members = vector_size(types);
+	vector record = vector_create(3 + 2 * members);
+	vector_increase(&record, 3);
+
 	item_t displ = 0;
 	for (size_t i = 0; i < members; i++)
 	{
-		const item_t type = vector_get(types, i);
-		const item_t name = vector_get(names, i);
+		const item_t type = vector_at(types, i);
+		const item_t name = vector_at(names, i);
 
-		local_modetab[local_md++] = type;
-		local_modetab[local_md++] = name;
+		vector_push_unchecked(&record, type);
+		vector_push_unchecked(&record, name);
 		displ += type_size(sx, type);
 	}
 
-	local_modetab[0] = TYPE_STRUCTURE;
-	local_modetab[1] = (item_t)displ;
-	local_modetab[2] = (item_t)members * 2;
-	return type_add(sx, local_modetab, local_md);
+	vector_set(&record, 0, TYPE_STRUCTURE);
+	vector_set(&record, 1, displ);
+	vector_set(&record, 2, (item_t)members * 2);
+
+	const size_t start_type = sx->start_type;
+	const item_t type = type_add(sx, record.array, vector_size(&record));
+	if (sx->start_type != start_type)
+	{
+		// Новая структура - строим индекс её членов
+		member_index_add_structure(sx, type);
+	}
+
+	vector_clear(&record);
+	return type;
 }
 
 size_t type_structure_get_member_amount(const syntax *const sx, const item_t type)
@@ -754,6 +784,22 @@ size_t type_structure_get_member_name(const syntax *const sx, const item_t type,
 		: type_is_structure(sx, type) ? (size_t)type_get(sx, (size_t)type + 4 + 2 * index) : SIZE_MAX;
 }
 
+size_t type_structure_get_member_index(const syntax *const sx, const item_t type, const size_t name)
+{
+	if (type_is_const(sx, type))
+	{
+		return type_structure_get_member_index(sx, type_const_get_unqualified_type(sx, type), name);
+	}
+
+	if (!type_is_structure(sx, type))
+	{
+		return SIZE_MAX;
+	}
+
+	const size_t slot = member_index_search(sx, type, name);
+	return vector_at(&sx->member_index, 3 * slot) != 0 ? (size_t)vector_at(&sx->member_index, 3 * slot + 2) : SIZE_MAX;
+}
+
 item_t type_structure_get_member_type(const syntax *const sx, const item_t type, const size_t index)
 {
 	return type_is_const(sx, type) ? type_structure_get_member_type(sx, type_const_get_unqualified_type(sx, type), index)
@@ -892,9 +938,23 @@ bool type_is_undefined(const item_t type)
 }
 
 
-size_t repr_reserve(syntax *const sx, char32_t *const last)
+size_t repr_reserve(syntax *const sx, const char *const spelling)
 {
-	return map_reserve_by_io(&sx->representations, sx->io, last);
+	const size_t repr = map_reserve(&sx->representations, spelling);
+	if (repr == SIZE_MAX || repr_get_reference(sx, repr) != ITEM_MAX)
+	{
+		return repr;
+	}
+
+	const keyword *const kw = keyword_find(spelling, strlen(spelling));
+	if (kw == NULL || kw->reference < 0)
+	{
+		return repr;
+	}
+
+	// Все написания встроенной функции ссылаются на неё
+	repr_set_reference(sx, repr, kw->reference);
+	return repr;
 }
 
 const char *repr_get_name(const syntax *const sx, const size_t index)
@@ -921,7 +981,7 @@ scope scope_block_enter(syntax *const sx)
 	}
 
 	size_t prev_cur_id = sx->cur_id;
-	sx->cur_id = vector_size(&sx->identifiers);
+	sx->cur_id = ident_get_amount(sx);
 	return (scope){ sx->displ, sx->lg, prev_cur_id };
 }
 
@@ -932,7 +992,7 @@ int scope_block_exit(syntax *const sx, const scope scp)
 		return -1;
 	}
 
-	for (size_t i = vector_size(&sx->identifiers) - 4; i >= sx->cur_id; i -= 4)
+	for (size_t i = ident_get_amount(sx) - 1; i >= sx->cur_id; i--)
 	{
 		const item_t prev = ident_get_prev(sx, i);
 		repr_set_reference(sx, (size_t)ident_get_repr(sx, i), prev == ITEM_MAX - 1 ? ITEM_MAX : prev);
@@ -952,7 +1012,7 @@ item_t scope_func_enter(syntax *const sx)
 	}
 
 	const item_t displ = sx->displ;
-	sx->cur_id = vector_size(&sx->identifiers);
+	sx->cur_id = ident_get_amount(sx);
 	sx->displ = 3;
 	sx->max_displ = 3;
 	sx->lg = 1;
@@ -967,13 +1027,13 @@ item_t scope_func_exit(syntax *const sx, const item_t displ)
 		return ITEM_MAX;
 	}
 
-	for (size_t i = vector_size(&sx->identifiers) - 4; i >= sx->cur_id; i -= 4)
+	for (size_t i = ident_get_amount(sx) - 1; i >= sx->cur_id; i--)
 	{
 		const item_t prev = ident_get_prev(sx, i);
 		repr_set_reference(sx, (size_t)ident_get_repr(sx, i), prev == ITEM_MAX - 1 ? ITEM_MAX : prev);
 	}
 
-	sx->cur_id = 2;	// Все функции описываются на одном уровне
+	sx->cur_id = 1;	// Все функции описываются на одном уровне
 	sx->lg = -1;
 	sx->displ = displ;
 
@@ -20,6 +20,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include "hash.h"
 #include "map.h"
 #include "reporter.h"
 #include "strings.h"
@@ -61,23 +62,37 @@ typedef enum TYPE
 } type_t;
 
 
+/** Identifiers table, identifier is the same index in all arrays */
+typedef struct ident_table
+{
+	cell_vector prevs;			/**< Previous declarations with the same representation */
+	cell_vector reprs;			/**< Indexes in representations table */
+	cell_vector types;			/**< Types */
+	cell_vector displs;			/**< Displacements */
+} ident_table;
+
 /** Global vars definition */
 typedef struct syntax
 {
 	universal_io *io;			/**< Universal io structure */
 	reporter rprt;				/**< Reporter */
+	arena *region;				/**< Memory region of tables */
 
 	strings string_literals;	/**< String literals list */
 
-	vector predef;				/**< Predefined functions table */
+	hash predef;				/**< Set of predefined functions without definition */
 	vector functions;			/**< Functions table */
 
-	vector tree;				/**< Tree table */
+	node_tree tree;				/**< Tree table */
 
-	vector identifiers;			/**< Identifiers table */
+	ident_table identifiers;	/**< Identifiers table */
 	size_t cur_id;				/**< Start of current scope in identifiers table */
 
 	vector types;				/**< Types table */
+	vector type_index;			/**< Hash index of types table */
+	size_t type_amount;			/**< Number of types in hash index */
+	vector member_index;		/**< Hash index of structure members by name */
+	size_t member_amount;		/**< Number of members in hash index */
 	size_t start_type;			/**< Start of last record in types table */
 
 	map representations;		/**< Representations table */
@@ -314,6 +329,15 @@ int ident_set_type(syntax *const sx, const size_t index, const item_t type);
  */
 int ident_set_displ(syntax *const sx, const size_t index, const item_t displ);
 
+/**
+ *	Get amount of records in identifiers table
+ *
+ *	@param	sx			Syntax structure
+ *
+ *	@return	Amount of records, all identifiers are less than it
+ */
+size_t ident_get_amount(const syntax *const sx);
+
 /**
  *	Check if identifier is declared as type specifier
  *
@@ -627,6 +651,17 @@ size_t type_structure_get_member_amount(const syntax *const sx, const item_t typ
  */
 size_t type_structure_get_member_name(const syntax *const sx, const item_t type, const size_t index);
 
+/**
+ *	Get member index by name
+ *
+ *	@param	sx			Syntax structure
+ *	@param	type		Structure type
+ *	@param	name		Member name
+ *
+ *	@return	Member number, @c SIZE_MAX on failure
+ */
+size_t type_structure_get_member_index(const syntax *const sx, const item_t type, const size_t name);
+
 /**
  *	Get member type by index
  *
@@ -741,14 +776,15 @@ item_t type_const(syntax *const sx, const item_t type);
 
 
 /**
- *	Add a new record from io to representations table or return existing
+ *	Add a new record to representations table or return existing,
+ *	spellings of main and builtin functions get their references on first addition
  *
  *	@param	sx			Syntax structure
- *	@param	last		Next character after key
+ *	@param	spelling	Identifier spelling
  *
  *	@return	Index of record, @c SIZE_MAX on failure
  */
-size_t repr_reserve(syntax *const sx, char32_t *const last);
+size_t repr_reserve(syntax *const sx, const char *const spelling);
 
 /**
  *	Get identifier name from representations table
@@ -2107,7 +2107,7 @@ void write_tree(const char *const path, syntax *const sx)
 
 void print_tree(syntax *const sx)
 {
-	printf("size:%llu\n", sx->tree.size);
+	printf("size:%llu\n", sx->tree.cells.size);
 	const node root = node_get_root(&sx->tree);
 
 	const size_t size = translation_unit_get_size(&root);
@@ -2118,11 +2118,11 @@ void print_tree(syntax *const sx)
 		//printf("size:%llu", size);
 	}
 
-	for (size_t i = 0; i < sx->tree.size; i++)
+	for (size_t i = 0; i < sx->tree.cells.size; i++)
 	{
 		//printf("%llu", declaration.tree->array[0]);
 		//printf("%llu  %llu %i\n", i, sx->tree.array[i], type_get_class(sx, i));
-		printf("%llu  %llu\n", i, sx->tree.array[i]);
+		printf("%llu  %llu\n", i, sx->tree.cells.array[i]);
 	}
 }
 
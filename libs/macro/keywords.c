@@ -18,6 +18,7 @@
 
 
 extern inline bool kw_is_correct(const keyword_t kw);
+extern inline bool kw_is_end(const keyword_t kw);
 
 
 static int add_keyword(map *const as
@@ -100,6 +100,18 @@ inline bool kw_is_correct(const keyword_t kw)
 	return BEGIN_KEYWORD < kw && kw < END_KEYWORD;
 }
 
+/**
+ *	Check that keyword is an end / else token of block
+ *
+ *	@param	kw				Keyword
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+inline bool kw_is_end(const keyword_t kw)
+{
+	return kw == KW_ELIF || kw == KW_ELSE || kw == KW_ENDIF || kw == KW_ENDW || kw == KW_ENDM;
+}
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -28,6 +28,9 @@
 #endif
 
 
+static const item_t PATH_ABSENT = -1;
+
+
 static void linker_make_path(char *const buffer, const char *const name, const char *const path, const bool is_file)
 {
 	size_t index = 0;
@@ -57,23 +60,36 @@ static void linker_make_path(char *const buffer, const char *const name, const c
 	buffer[index] = '\0';
 }
 
-static inline size_t linker_internal_path(linker *const lk, const char *const file)
+static size_t linker_access(linker *const lk, const char *const path)
 {
-	char path[MAX_ARG_SIZE];
-	linker_make_path(path, file, ws_get_file(lk->ws, lk->current), true);
+	// Файловая система проверяется один раз для каждого пути, в том числе отсутствующего
+	const item_t cached = map_get(&lk->paths, path);
+	if (cached != ITEM_MAX)
+	{
+		lk->hits++;
+		return cached != PATH_ABSENT ? (size_t)cached : SIZE_MAX;
+	}
 
+	size_t index = SIZE_MAX;
 	if (access(path, F_OK) != -1)
 	{
 		const size_t size = ws_get_files_num(lk->ws);
-		const size_t index = ws_add_file(lk->ws, path);
+		index = ws_add_file(lk->ws, path);
 		if (index == size)
 		{
 			vector_add(&lk->included, 0);
 		}
-		return index;
 	}
 
-	return SIZE_MAX;
+	map_add(&lk->paths, path, index != SIZE_MAX ? (item_t)index : PATH_ABSENT);
+	return index;
+}
+
+static inline size_t linker_internal_path(linker *const lk, const char *const file)
+{
+	char path[MAX_ARG_SIZE];
+	linker_make_path(path, file, ws_get_file(lk->ws, lk->current), true);
+	return linker_access(lk, path);
 }
 
 static inline size_t linker_external_path(linker *const lk, const char *const file)
@@ -83,14 +99,9 @@ static inline size_t linker_external_path(linker *const lk, const char *const fi
 	{
 		linker_make_path(path, file, ws_get_dir(lk->ws, i), false);
 
-		if (access(path, F_OK) != -1)
+		const size_t index = linker_access(lk, path);
+		if (index != SIZE_MAX)
 		{
-			const size_t size = ws_get_files_num(lk->ws);
-			const size_t index = ws_add_file(lk->ws, path);
-			if (index == size)
-			{
-				vector_add(&lk->included, 0);
-			}
 			return index;
 		}
 	}
@@ -99,6 +110,13 @@ static inline size_t linker_external_path(linker *const lk, const char *const fi
 }
 
 
+static inline int linker_open(const linker *const lk, universal_io *const io, const size_t index)
+{
+	const char *const path = ws_get_file(lk->ws, index);
+	return ws_has_flag(lk->ws, "-mmap") ? in_set_mmap(io, path) : in_set_file(io, path);
+}
+
+
 /*
  *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
  *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
@@ -111,7 +129,7 @@ static inline size_t linker_external_path(linker *const lk, const char *const fi
 linker linker_create(workspace *const ws)
 {
 	linker lk = { .ws = ws, .sources = ws_get_files_num(ws),
-		.included = vector_create(MAX_PATHS), .current = SIZE_MAX };
+		.included = vector_create(MAX_PATHS), .paths = map_create(MAX_PATHS), .hits = 0, .current = SIZE_MAX };
 
 	vector_increase(&lk.included, lk.sources);
 	return lk;
@@ -122,7 +140,7 @@ universal_io linker_add_source(linker *const lk, const size_t index)
 {
 	universal_io input = io_create();
 
-	if (linker_is_correct(lk) && in_set_file(&input, ws_get_file(lk->ws, index)) == 0)
+	if (linker_is_correct(lk) && linker_open(lk, &input, index) == 0)
 	{
 		vector_set(&lk->included, index, 1);
 		lk->current = index;
@@ -135,7 +153,7 @@ universal_io linker_add_header(linker *const lk, const size_t index)
 {
 	universal_io input = io_create();
 	if (linker_is_correct(lk) && vector_get(&lk->included, index) != 1
-		&& in_set_file(&input, ws_get_file(lk->ws, index)) == 0)
+		&& linker_open(lk, &input, index) == 0)
 	{
 		vector_set(&lk->included, index, 1);
 		lk->current = index;
@@ -190,6 +208,12 @@ const char* linker_current_path(const linker *const lk)
 }
 
 
+size_t linker_get_hits(const linker *const lk)
+{
+	return linker_is_correct(lk) ? lk->hits : 0;
+}
+
+
 size_t linker_size(const linker *const lk)
 {
 	return linker_is_correct(lk) ? ws_get_files_num(lk->ws) : SIZE_MAX;
@@ -203,10 +227,11 @@ bool linker_is_correct(const linker *const lk)
 
 int linker_clear(linker *const lk)
 {
-	if (lk != NULL)
+	if (lk == NULL)
 	{
 		return -1;
 	}
 
+	map_clear(&lk->paths);
 	return vector_clear(&lk->included);
 }
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "workspace.h"
+#include "map.h"
 #include "vector.h"
 #include "uniio.h"
 
@@ -36,6 +37,9 @@ typedef struct linker
 
 	vector included;			/**< List of included files */
 
+	map paths;					/**< Checked paths, index of file or @c -1 if file is absent */
+	size_t hits;				/**< Number of path checks without file system access */
+
 	size_t current; 			/**< Index of current file */
 } linker;
 
@@ -121,6 +125,16 @@ size_t linker_get_index(const linker *const lk);
 int linker_set_index(linker *const lk, const size_t index);
 
 
+/**
+ *	Get number of include path checks done without file system access
+ *
+ *	@param	lk			Linker structure
+ *
+ *	@return	Number of hits
+ */
+size_t linker_get_hits(const linker *const lk);
+
+
 /**
  *	Get number of linker files
  *
@@ -106,7 +106,7 @@ static inline int ws_parse(const workspace *const ws, storage *const stg)
 }
 
 
-static int macro_form_io(workspace *const ws, universal_io *const output)
+static int macro_form_io(workspace *const ws, universal_io *const output, size_t *const hits)
 {
 	linker lk = linker_create(ws);
 	storage stg = storage_create();
@@ -129,6 +129,11 @@ static int macro_form_io(workspace *const ws, universal_io *const output)
 		in_clear(&in);
 	}
 
+	if (hits != NULL)
+	{
+		*hits = linker_get_hits(&lk);
+	}
+
 	parser_clear(&prs);
 	storage_clear(&stg);
 	linker_clear(&lk);
@@ -146,6 +151,11 @@ static int macro_form_io(workspace *const ws, universal_io *const output)
 
 
 char *macro(workspace *const ws)
+{
+	return macro_with_hits(ws, NULL);
+}
+
+char *macro_with_hits(workspace *const ws, size_t *const hits)
 {
 	if (ws_get_files_num(ws) == 0)
 	{
@@ -160,7 +170,7 @@ char *macro(workspace *const ws)
 		return NULL;
 	}
 
-	int ret = macro_form_io(ws, &io);
+	int ret = macro_form_io(ws, &io, hits);
 	if (ret)
 	{
 		io_erase(&io);
@@ -186,9 +196,40 @@ int macro_to_file(workspace *const ws, const char *const path)
 		return -1;
 	}
 
-	int ret = macro_form_io(ws, &io);
+	int ret = macro_form_io(ws, &io, NULL);
+
+	io_erase(&io);
+	return ret;
+}
+
+int macro_to_stream(workspace *const ws, stream *const strm)
+{
+	if (ws_get_files_num(ws) == 0)
+	{
+		macro_system_error(TAG_LINKER, LINKER_NO_INPUT);
+		stream_fail(strm);
+		return -1;
+	}
+
+	universal_io io = io_create();
+	if (out_set_stream(&io, strm))
+	{
+		macro_system_error(TAG_LINKER, LINKER_WRONG_IO);
+		stream_fail(strm);
+		return -1;
+	}
+
+	int ret = macro_form_io(ws, &io, NULL);
 
 	io_erase(&io);
+	if (ret)
+	{
+		// Получатель не должен разбирать текст, который препроцессор не довёл до конца
+		stream_fail(strm);
+		return ret;
+	}
+
+	stream_close(strm);
 	return ret;
 }
 
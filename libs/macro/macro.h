@@ -17,6 +17,7 @@
 #pragma once
 
 #include "dll.h"
+#include "stream.h"
 #include "workspace.h"
 
 
@@ -33,6 +34,16 @@ extern "C" {
  */
 EXPORTED char *macro(workspace *const ws);
 
+/**
+ *	Preprocess files from workspace and count include path checks done without file system access
+ *
+ *	@param	ws		Workspace
+ *	@param	hits	Number of cached include path checks, may be @c NULL
+ *
+ *	@return	Preprocessed string, @c NULL on failure
+ */
+EXPORTED char *macro_with_hits(workspace *const ws, size_t *const hits);
+
 /**
  *	Preprocess files from workspace
  *
@@ -43,6 +54,17 @@ EXPORTED char *macro(workspace *const ws);
  */
 EXPORTED int macro_to_file(workspace *const ws, const char *const path);
 
+/**
+ *	Preprocess files from workspace to stream, stream is closed at the end
+ *	or marked as failed if preprocessing failed
+ *
+ *	@param	ws		Workspace
+ *	@param	strm	Output stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int macro_to_stream(workspace *const ws, stream *const strm);
+
 
 /**
  *	Preprocess files from terminal arguments
@@ -18,6 +18,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "computer.h"
+#include "decimal.h"
 #include "error.h"
 #include "keywords.h"
 #include "uniprinter.h"
@@ -37,18 +38,63 @@
 static const size_t MAX_INCLUDE_DEPTH = 32;
 static const size_t MAX_CALL_DEPTH = 256;
 static const size_t MAX_ITERATION = 32768;
+static const size_t MAX_UNMARKED_LINES = 1024;
 
 static const size_t MAX_COMMENT_SIZE = 4096;
 static const size_t MAX_VALUE_SIZE = 4096;
 static const size_t MAX_PATH_SIZE = 1024;
 
 
+/** Kinds of argument values in replacement list */
+typedef enum SLOT
+{
+	SLOT_TOKEN_PASTE,			/**< Read value for token-pasting operator */
+	SLOT_ARGUMENT,				/**< Preprocessed value */
+	SLOT_STRING,				/**< Value for stringizing operator */
+
+	SLOT_KINDS,					/**< Number of value kinds */
+} slot_t;
+
+/** Fields of captured step in loop body */
+typedef enum STEP
+{
+	STEP_POSITION,				/**< Input position of step */
+	STEP_LEXEMES,				/**< Start of lexemes, @c 0 if not captured, @c -1 for parsed step */
+	STEP_PREFIX_MARK,			/**< Line beginning with position directive */
+	STEP_PREFIX,				/**< Line beginning without position directive */
+
+	STEP_FIELDS,				/**< Number of step fields */
+} step_t;
+
+/** Fields of captured lexeme in usual line */
+typedef enum LEXEME
+{
+	LEXEME_FROM,				/**< Input position before spaces */
+	LEXEME_SPACES,				/**< Spaces and comments output */
+	LEXEME_AT,					/**< Input position of lexeme */
+	LEXEME_LINE,				/**< Line number of lexeme */
+	LEXEME_CODE,				/**< Code line position of lexeme */
+	LEXEME_TEXT,				/**< Lexeme output, negative for identifier */
+
+	LEXEME_FIELDS,				/**< Number of lexeme fields */
+} lexeme_t;
+
+/** Captured body of @c #while directive */
+typedef struct loop
+{
+	vector steps;				/**< Records of body steps */
+	vector lexemes;				/**< Lexemes of usual lines */
+	strings texts;				/**< Output texts of steps and lexemes */
+} loop;
+
+
 static keyword_t parse_directive(parser *const prs);
 static location parse_location(parser *const prs);
 static bool parse_next(parser *const prs, const keyword_t begin, const keyword_t next);
 static bool parse_name(parser *const prs);
 static char32_t parse_line(parser *const prs);
 static keyword_t parse_block(parser *const prs, const keyword_t begin);
+static char32_t parse_keyword(parser *const prs, const keyword_t keyword);
 
 
 /**
@@ -521,8 +567,7 @@ static keyword_t skip_block(parser *const prs, const keyword_t begin)
 			prs->was_error = was_error;
 		}
 
-		if (keyword == KW_ELIF || keyword == KW_ELSE || keyword == KW_ENDIF
-			|| keyword == KW_ENDW || keyword == KW_ENDM)
+		if (kw_is_end(keyword))
 		{
 			if (!parse_next(prs, begin, keyword))
 			{
@@ -569,23 +614,314 @@ static keyword_t skip_block(parser *const prs, const keyword_t begin)
 }
 
 
+/*
+ *	Запись кадра аргументов вызова в slots:
+ *		[values size before call][value of slot 0]...[value of slot N-1]
+ *	Кадры вложенных вызовов лежат выше по стеку и снимаются раньше
+ */
+
+
+/**
+ *	Push argument frame of macro call
+ *
+ *	@param	prs			Parser structure
+ *
+ *	@return	Argument frame
+ */
+static inline size_t frame_push(parser *const prs)
+{
+	return vector_add(&prs->slots, (item_t)strings_size(&prs->values));
+}
+
+/**
+ *	Add value to the top argument frame.
+ *	Values are added in order of @c slot_t for each argument.
+ *
+ *	@param	prs			Parser structure
+ *	@param	value		Value
+ */
+static inline void frame_add(parser *const prs, const char *const value)
+{
+	const size_t index = strings_add(&prs->values, value);
+	vector_add(&prs->slots, index != SIZE_MAX ? (item_t)index : ITEM_MAX);
+}
+
+/**
+ *	Get value of argument slot
+ *
+ *	@param	prs			Parser structure
+ *	@param	frm			Argument frame
+ *	@param	slot		Argument slot
+ *
+ *	@return	Value of argument
+ */
+static inline const char *frame_get(const parser *const prs, const size_t frm, const size_t slot)
+{
+	const item_t index = vector_get(&prs->slots, frm + 1 + slot);
+	return index != ITEM_MAX ? strings_get(&prs->values, (size_t)index) : "";
+}
+
+/**
+ *	Pop argument frame with all frames above it
+ *
+ *	@param	prs			Parser structure
+ *	@param	frm			Argument frame
+ */
+static inline void frame_pop(parser *const prs, const size_t frm)
+{
+	const size_t size = (size_t)vector_get(&prs->slots, frm);
+	while (strings_size(&prs->values) > size)
+	{
+		strings_remove(&prs->values);
+	}
+
+	vector_resize(&prs->slots, frm);
+}
+
+
+/**
+ *	Check that macro value is pasted to output as is.
+ *	Such value has no identifiers, strings, comments and directives.
+ *
+ *	@param	value		Macro value
+ *
+ *	@return	@c true on success, @c false on failure
+ */
+static bool replacement_is_plain(const char *const value)
+{
+	if (value == NULL || value[0] == '\0')
+	{
+		return false;
+	}
+
+	for (size_t i = 0; value[i] != '\0'; i++)
+	{
+		const unsigned char character = (unsigned char)value[i];
+		if (character >= 0x80 || utf8_is_letter(character) || strchr("#'\"/\\\r\n", character) != NULL)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ *	Add literal part to the compiled replacement list.
+ *	Empty literals are skipped.
+ *
+ *	@param	prs			Parser structure
+ *	@param	buffer		Extracted literal buffer
+ */
+static inline void replacement_add_literal(parser *const prs, char *const buffer)
+{
+	const size_t index = strings_add(&prs->literals, buffer);
+	if (index != SIZE_MAX)
+	{
+		vector_add(&prs->segments, (item_t)index);
+	}
+
+	free(buffer);
+}
+
+/**
+ *	Compile macro value to replacement list.
+ *	Apply observation area to the value once,
+ *	so that arguments become references to slots.
+ *
+ *	@param	prs			Parser structure
+ *	@param	index		Index of macro
+ *
+ *	@return	Start of replacement list in segments
+ */
+static size_t replacement_compile(parser *const prs, const size_t index)
+{
+	const char *const value = storage_get_by_index(prs->stg, index);
+	const size_t args = storage_get_args_by_index(prs->stg, index);
+
+	const size_t record = vector_add(&prs->segments, args == 0 && replacement_is_plain(value));
+	vector_add(&prs->segments, 0);
+
+	if (args != 0 && value != NULL)
+	{
+		// Номер слота маски хранится в поле количества аргументов
+		storage masks = storage_create();
+		char mask[MAX_MASK_SIZE];
+		for (size_t i = 0; i < args; i++)
+		{
+			sprintf(mask, MASK_TOKEN_PASTE "%zu" MASK_SUFFIX "%zu", index, i);
+			storage_set_args_by_index(&masks, storage_add(&masks, mask), i * SLOT_KINDS + SLOT_TOKEN_PASTE);
+			sprintf(mask, MASK_ARGUMENT "%zu" MASK_SUFFIX "%zu", index, i);
+			storage_set_args_by_index(&masks, storage_add(&masks, mask), i * SLOT_KINDS + SLOT_ARGUMENT);
+			sprintf(mask, MASK_STRING "%zu" MASK_SUFFIX "%zu", index, i);
+			storage_set_args_by_index(&masks, storage_add(&masks, mask), i * SLOT_KINDS + SLOT_STRING);
+		}
+
+		universal_io *io = prs->io;
+		universal_io body = io_create();
+		in_set_buffer(&body, value);
+		out_set_buffer(&body, MAX_VALUE_SIZE);
+		prs->io = &body;
+
+		location *loc = prs->loc;
+		prs->loc = NULL;
+
+		for (char32_t ch = skip_until(prs, true); ch != (char32_t)EOF; ch = skip_until(prs, true))
+		{
+			if (ch == '#' || utf8_is_letter(ch))
+			{
+				const size_t current = storage_search(&masks, prs->io);
+				if (kw_is_correct(current) || current == SIZE_MAX)
+				{
+					uni_printf(prs->io, "%s", storage_last_read(&masks));
+					continue;
+				}
+
+				replacement_add_literal(prs, out_extract_buffer(prs->io));
+				out_set_buffer(prs->io, MAX_VALUE_SIZE);
+				vector_add(&prs->segments, -1 - (item_t)storage_get_args_by_index(&masks, current));
+			}
+			else if (ch == '\'' || ch == '"')
+			{
+				uni_print_char(prs->io, uni_scan_char(prs->io));
+				uni_print_char(prs->io, skip_string(prs, ch));
+			}
+			else
+			{
+				uni_print_char(prs->io, uni_scan_char(prs->io));
+			}
+		}
+
+		replacement_add_literal(prs, out_extract_buffer(prs->io));
+		prs->loc = loc;
+		prs->io = io;
+
+		in_clear(&body);
+		storage_clear(&masks);
+	}
+
+	vector_set(&prs->segments, record + 1, (item_t)(vector_size(&prs->segments) - record - 2));
+	return record;
+}
+
+/**
+ *	Get compiled replacement list of macro.
+ *	Compile macro value on first use.
+ *
+ *	@param	prs			Parser structure
+ *	@param	index		Index of macro
+ *
+ *	@return	Start of replacement list in segments
+ */
+static size_t replacement_get(parser *const prs, const size_t index)
+{
+	if (index < vector_size(&prs->compiled) && vector_get(&prs->compiled, index) != 0)
+	{
+		return (size_t)vector_get(&prs->compiled, index);
+	}
+
+	const size_t record = replacement_compile(prs, index);
+	if (index >= vector_size(&prs->compiled))
+	{
+		vector_resize(&prs->compiled, index + 1);
+	}
+
+	vector_set(&prs->compiled, index, (item_t)record);
+	return record;
+}
+
+/**
+ *	Copy replacement lists of all macros into new tables without outdated lists
+ *
+ *	@param	prs			Parser structure
+ */
+static void replacement_compact(parser *const prs)
+{
+	vector segments = vector_create(vector_size(&prs->segments) - prs->replaced);
+	vector_increase(&segments, 1);
+	strings literals = strings_create(MAX_CALL_DEPTH);
+
+	const size_t amount = vector_size(&prs->compiled);
+	for (size_t i = 0; i < amount; i++)
+	{
+		const size_t record = (size_t)vector_get(&prs->compiled, i);
+		if (record == 0)
+		{
+			continue;
+		}
+
+		const size_t size = (size_t)vector_get(&prs->segments, record + 1);
+		vector_set(&prs->compiled, i, (item_t)vector_add(&segments, vector_get(&prs->segments, record)));
+		vector_add(&segments, (item_t)size);
+
+		for (size_t j = 0; j < size; j++)
+		{
+			const item_t segment = vector_get(&prs->segments, record + 2 + j);
+			vector_add(&segments, segment >= 0
+				? (item_t)strings_add(&literals, strings_get(&prs->literals, (size_t)segment)) : segment);
+		}
+	}
+
+	vector_clear(&prs->segments);
+	strings_clear(&prs->literals);
+
+	prs->segments = segments;
+	prs->literals = literals;
+	prs->replaced = 0;
+}
+
+/**
+ *	Reset compiled replacement list after macro value changed.
+ *	The last list is truncated, others are collected when they take most of segments.
+ *
+ *	@param	prs			Parser structure
+ *	@param	index		Index of macro
+ */
+static void replacement_reset(parser *const prs, const size_t index)
+{
+	if (index >= vector_size(&prs->compiled) || vector_get(&prs->compiled, index) == 0)
+	{
+		return;
+	}
+
+	const size_t record = (size_t)vector_get(&prs->compiled, index);
+	const size_t size = (size_t)vector_get(&prs->segments, record + 1);
+	vector_set(&prs->compiled, index, 0);
+
+	if (record + 2 + size == vector_size(&prs->segments))
+	{
+		// Литералы последнего списка также лежат в конце
+		for (size_t i = 0; i < size; i++)
+		{
+			if (vector_get(&prs->segments, record + 2 + i) >= 0)
+			{
+				strings_remove(&prs->literals);
+			}
+		}
+
+		vector_resize(&prs->segments, record);
+		return;
+	}
+
+	prs->replaced += 2 + size;
+	if (2 * prs->replaced > vector_size(&prs->segments))
+	{
+		replacement_compact(prs);
+	}
+}
+
+
 /**
  *	Parse read value of macro argument.
- *	Produce masked arguments for preprocessor operators.
+ *	Produce values of argument slots for preprocessor operators.
  *	Creates preprocessed value, stringizing and token-pasting operators.
  *
  *	@param	prs			Parser structure
- *	@param	index		Index of macro
- *	@param	stg			Value storage
  *	@param	value		Read argument
- *	@param	arg			Argument number
  */
-static inline void parse_values(parser *const prs, const size_t index, storage *const stg
-	, char *const value, const size_t arg)
+static inline void parse_values(parser *const prs, char *const value)
 {
-	char mask[MAX_MASK_SIZE];
-	sprintf(mask, MASK_TOKEN_PASTE "%zu" MASK_SUFFIX "%zu", index, arg);
-	storage_set_by_index(stg, storage_add(stg, mask), value);
+	frame_add(prs, value);
 
 	universal_io io = io_create();
 	in_set_buffer(&io, value);
@@ -595,8 +931,7 @@ static inline void parse_values(parser *const prs, const size_t index, storage *
 	out_swap(prs->io, &io);
 
 	char *buffer = out_extract_buffer(&io);
-	sprintf(mask, MASK_ARGUMENT "%zu" MASK_SUFFIX "%zu", index, arg);
-	storage_set_by_index(stg, storage_add(stg, mask), buffer);
+	frame_add(prs, buffer);
 	free(buffer);
 
 	in_set_position(&io, 0);
@@ -617,23 +952,21 @@ static inline void parse_values(parser *const prs, const size_t index, storage *
 	in_clear(&io);
 
 	buffer = out_extract_buffer(&io);
-	sprintf(mask, MASK_STRING "%zu" MASK_SUFFIX "%zu", index, arg);
-	storage_set_by_index(stg, storage_add(stg, mask), buffer);
+	frame_add(prs, buffer);
 	free(buffer);
 }
 
 /**
  *	Parse macro argument values from brackets.
- *	Produce values for replacement to storage.
+ *	Produce values for replacement to the top argument frame.
  *	Stopped without closing bracket read.
  *
  *	@param	prs			Parser structure
  *	@param	index		Index of macro
- *	@param	stg			Value storage
  *
  *	@return	Number of read values, @c SIZE_MAX on failure
  */
-static inline size_t parse_brackets(parser *const prs, const size_t index, storage *const stg)
+static inline size_t parse_brackets(parser *const prs, const size_t index)
 {
 	size_t arg = 0;
 	char32_t character = '\0';
@@ -673,7 +1006,8 @@ static inline size_t parse_brackets(parser *const prs, const size_t index, stora
 		if (arg != SIZE_MAX)
 		{
 			char *buffer = out_extract_buffer(prs->io);
-			parse_values(prs, index, stg, buffer, arg++);
+			parse_values(prs, buffer);
+			arg++;
 			free(buffer);
 		}
 	}
@@ -685,46 +1019,27 @@ static inline size_t parse_brackets(parser *const prs, const size_t index, stora
 
 /**
  *	Parse macro replacement value.
- *	Apply arguments and operators to comply observation area.
+ *	Splice argument values into the compiled replacement list.
  *	After that, preprocess the result value.
  *
  *	@param	prs			Parser structure
  *	@param	index		Index of macro
- *	@param	stg			Value storage
+ *	@param	frm			Argument frame
  */
-static inline void parse_observation(parser *const prs, const size_t index, storage *const stg)
+static inline void parse_observation(parser *const prs, const size_t index, const size_t frm)
 {
-	universal_io *io = prs->io;
+	const size_t record = replacement_get(prs, index);
+	const size_t amount = (size_t)vector_get(&prs->segments, record + 1);
+
 	universal_io value = io_create();
-	in_set_buffer(&value, storage_get_by_index(prs->stg, index));
 	out_set_buffer(&value, MAX_VALUE_SIZE);
-	prs->io = &value;
-
-	location *loc = prs->loc;
-	prs->loc = NULL;
-
-	for (char32_t ch = skip_until(prs, true); ch != (char32_t)EOF; ch = skip_until(prs, true))
+	for (size_t i = 0; i < amount; i++)
 	{
-		if (ch == '#' || utf8_is_letter(ch))
-		{
-			const size_t current = storage_search(stg, prs->io);
-			uni_printf(prs->io, "%s", kw_is_correct(current) || current == SIZE_MAX
-				? storage_last_read(stg) : storage_get_by_index(stg, current));
-		}
-		else if (ch == '\'' || ch == '"')
-		{
-			uni_print_char(prs->io, uni_scan_char(prs->io));
-			uni_print_char(prs->io, skip_string(prs, ch));
-		}
-		else
-		{
-			uni_print_char(prs->io, uni_scan_char(prs->io));
-		}
+		const item_t segment = vector_get(&prs->segments, record + 2 + i);
+		uni_printf(&value, "%s", segment >= 0
+			? strings_get(&prs->literals, (size_t)segment) : frame_get(prs, frm, (size_t)(-1 - segment)));
 	}
 
-	prs->loc = loc;
-	prs->io = io;
-
 	char *buffer = out_extract_buffer(&value);
 	in_set_buffer(&value, buffer);
 	parser_preprocess(prs, &value);
@@ -757,6 +1072,14 @@ static bool parse_replacement(parser *const prs, const size_t index)
 			in_set_position(prs->io, position);
 		}
 
+		if (vector_get(&prs->segments, replacement_get(prs, index)) != 0)
+		{
+			// Значение без идентификаторов вставляется так же, как после повторного разбора
+			uni_printf(prs->io, "%s%s", storage_get_by_index(prs->stg, index), prs->prev == NULL ? "\n" : "");
+			prs->is_line_required = false;
+			return true;
+		}
+
 		universal_io value = io_create();
 		in_set_buffer(&value, storage_get_by_index(prs->stg, index));
 		parser_preprocess(prs, &value);
@@ -772,11 +1095,11 @@ static bool parse_replacement(parser *const prs, const size_t index)
 		return false;
 	}
 
-	storage stg = storage_create();
-	const size_t actual = parse_brackets(prs, index, &stg);
+	const size_t frm = frame_push(prs);
+	const size_t actual = parse_brackets(prs, index);
 	if (expected == actual)
 	{
-		parse_observation(prs, index, &stg);
+		parse_observation(prs, index, frm);
 	}
 	else if (actual != SIZE_MAX)
 	{
@@ -786,7 +1109,7 @@ static bool parse_replacement(parser *const prs, const size_t index)
 	}
 
 	uni_scan_char(prs->io);
-	storage_clear(&stg);
+	frame_pop(prs, frm);
 	return expected == actual;
 }
 
@@ -912,6 +1235,13 @@ static inline char32_t parse_until(parser *const prs)
  */
 static inline char32_t parse_hash(parser *const prs, universal_io *const out)
 {
+	// Получатель потока хранит текст только от последней отметки, поэтому она повторяется
+	const bool is_streamed = prs->call == 0 && out_is_stream(prs->io);
+	if (is_streamed && (prs->loc->line < prs->marked || prs->loc->line >= prs->marked + MAX_UNMARKED_LINES))
+	{
+		prs->is_line_required = true;
+	}
+
 	out_swap(prs->io, out);
 	out_set_buffer(prs->io, MAX_COMMENT_SIZE);
 
@@ -921,6 +1251,7 @@ static inline char32_t parse_hash(parser *const prs, universal_io *const out)
 		{
 			out_set_buffer(prs->io, MAX_COMMENT_SIZE);
 			loc_update(prs->loc);
+			prs->marked = is_streamed ? prs->loc->line : prs->marked;
 		}
 
 		char32_t character = skip_until(prs, true);
@@ -1102,9 +1433,11 @@ static inline void parse_path(parser *const prs, const char32_t quote)
 	}
 
 	parse_extra(prs, storage_last_read(prs->stg));
+	const size_t current = linker_get_index(prs->lk);
 	universal_io header = linker_add_header(prs->lk, index);
 	parser_preprocess(prs, &header);
 	in_clear(&header);
+	linker_set_index(prs->lk, current);
 }
 
 /**
@@ -1182,6 +1515,38 @@ static inline bool parse_suffix(parser *const prs)
 	}
 }
 
+/**
+ *	Scan digits of an integer number, too large number is saturated
+ *
+ *	@param	prs			Parser structure
+ *	@param	base		Number base
+ *	@param	number		Scanned number
+ *
+ *	@return	Number of scanned digits
+ */
+static size_t scan_digits(parser *const prs, const uint8_t base, uint64_t *const number)
+{
+	size_t digits = 0;
+	char32_t character = uni_scan_char(prs->io);
+	while (utf8_is_hexa_digit(character) && utf8_to_number(character) < base)
+	{
+		if (decimal_add_integer_digit(number, base, utf8_to_number(character)) || *number > INT64_MAX)
+		{
+			*number = INT64_MAX;
+		}
+
+		digits++;
+		character = uni_scan_char(prs->io);
+	}
+
+	if (character != (char32_t)EOF)
+	{
+		uni_unscan_char(prs->io, character);
+	}
+
+	return digits;
+}
+
 /**
  *	Parse an integer number for the expression computer.
  *	First character should be checked before call.
@@ -1196,38 +1561,36 @@ static inline bool parse_number(parser *const prs, computer *const comp, const s
 {
 	location loc = loc_copy(prs->loc);
 
-	unsigned long long number = 0;
-	uni_scanf(prs->io, "%lld", &number);
+	uint64_t number = 0;
+	scan_digits(prs, 10, &number);
 	size_t position = in_get_position(prs->io);
 	char32_t character = skip_until(prs, false);
 
 	if (number == 0 && pos + 1 == in_get_position(prs->io))
 	{
-		bool was_error = false;
+		uint8_t base = 0;
 		if (character == 'x' || character == 'X')
 		{
-			uni_scan_char(prs->io);
-			was_error = uni_scanf(prs->io, "%llx", &number) != 1;
+			base = 16;
 		}
 		else if (character == 'd' || character == 'D')
 		{
-			uni_scan_char(prs->io);
-			was_error = uni_scanf(prs->io, "%lld", &number) != 1;
+			base = 10;
 		}
 		else if (character == 'o' || character == 'O')
 		{
-			uni_scan_char(prs->io);
-			was_error = uni_scanf(prs->io, "%llo", &number) != 1;
+			base = 8;
 		}
 		else if (character == 'b' || character == 'B')
 		{
-			char buffer[100] = "";
+			base = 2;
+		}
+
+		bool was_error = false;
+		if (base != 0)
+		{
 			uni_scan_char(prs->io);
-			was_error = uni_scanf(prs->io, "%99[01]", buffer) != 1;
-			for (size_t i = 0; buffer[i] != '\0'; i++)
-			{
-				number = (number << 1) | (buffer[i] - '0');
-			}
+			was_error = scan_digits(prs, base, &number) == 0;
 		}
 
 		if (!was_error)
@@ -1893,6 +2256,7 @@ static void parse_context(parser *const prs, const size_t index)
 			{
 				parser_error(prs, prs->loc, HASH_ON_EDGE);
 				storage_remove_by_index(prs->stg, index);
+				replacement_reset(prs, index);
 				storage_clear(&args);
 				return;
 			}
@@ -1908,6 +2272,7 @@ static void parse_context(parser *const prs, const size_t index)
 		{
 			storage_set_args_by_index(prs->stg, index, amount);
 			storage_set_by_index(prs->stg, index, value);
+			replacement_reset(prs, index);
 			free(value);
 
 			storage_clear(&args);
@@ -1916,6 +2281,7 @@ static void parse_context(parser *const prs, const size_t index)
 	}
 
 	storage_remove_by_index(prs->stg, index);
+	replacement_reset(prs, index);
 	storage_clear(&args);
 }
 
@@ -1989,7 +2355,9 @@ static inline char32_t parse_undef(parser *const prs)
 
 	if (parse_name(prs))
 	{
-		storage_remove_by_index(prs->stg, storage_search(prs->stg, prs->io));
+		const size_t index = storage_search(prs->stg, prs->io);
+		storage_remove_by_index(prs->stg, index);
+		replacement_reset(prs, index);
 	}
 
 	parse_extra(prs, directive);
@@ -2063,9 +2431,348 @@ static inline char32_t parse_macro(parser *const prs)
 		storage_remove_by_index(prs->stg, index);
 	}
 
+	replacement_reset(prs, index);
+
 	return character;
 }
 
+/*
+ *	Тело цикла #while разбирается по шагам, как в parse_block.
+ *	Шаг начинается с позиции, на которой остановился предыдущий, поэтому
+ *	повторные итерации находят записанные шаги по позиции во входном потоке.
+ *
+ *	Запись обычной строки в lexemes:
+ *		[amount][end position][last line][lexeme 0]...[lexeme N-1]
+ *	Номера строк записаны вместе с лексемами, чтобы отметки #line
+ *	и сообщения при раскрытии макросов не искали их во входном потоке
+ */
+
+/**
+ *	Create captured loop body
+ *
+ *	@return	Loop structure
+ */
+static inline loop loop_create(void)
+{
+	loop lp;
+	lp.steps = vector_create(MAX_CALL_DEPTH * STEP_FIELDS);
+	lp.lexemes = vector_create(MAX_VALUE_SIZE);
+	vector_increase(&lp.lexemes, 1);
+	lp.texts = strings_create(MAX_VALUE_SIZE);
+	return lp;
+}
+
+/**
+ *	Add output text to the captured loop body
+ *
+ *	@param	lp			Loop structure
+ *	@param	buffer		Extracted output buffer
+ *
+ *	@return	Index of text, @c ITEM_MAX for empty text
+ */
+static inline item_t loop_add_text(loop *const lp, char *const buffer)
+{
+	const size_t index = strings_add(&lp->texts, buffer);
+	free(buffer);
+	return index != SIZE_MAX ? (item_t)index : ITEM_MAX;
+}
+
+/**
+ *	Get output text of the captured loop body
+ *
+ *	@param	lp			Loop structure
+ *	@param	index		Index of text
+ *
+ *	@return	Output text
+ */
+static inline const char *loop_get_text(const loop *const lp, const item_t index)
+{
+	return index != ITEM_MAX ? strings_get(&lp->texts, (size_t)index) : "";
+}
+
+/**
+ *	Find step of loop body by input position.
+ *	Add new step, if it has not been reached before.
+ *
+ *	@param	lp			Loop structure
+ *	@param	position	Input position
+ *	@param	expected	Expected step
+ *
+ *	@return	Step record
+ */
+static size_t loop_get_step(loop *const lp, const size_t position, const size_t expected)
+{
+	const size_t size = vector_size(&lp->steps);
+	if (expected < size && (size_t)vector_get(&lp->steps, expected + STEP_POSITION) == position)
+	{
+		return expected;
+	}
+
+	for (size_t i = 0; i < size; i += STEP_FIELDS)
+	{
+		if ((size_t)vector_get(&lp->steps, i + STEP_POSITION) == position)
+		{
+			return i;
+		}
+	}
+
+	const size_t step = vector_add(&lp->steps, (item_t)position);
+	vector_add(&lp->steps, 0);
+	vector_add(&lp->steps, -1);
+	vector_add(&lp->steps, -1);
+	return step;
+}
+
+/**
+ *	Capture usual line lexemes after line beginning.
+ *	Identifiers are saved by names, other lexemes by their output.
+ *	Nothing is captured, if the line has stray hash or unterminated lexeme.
+ *
+ *	@param	prs			Parser structure
+ *	@param	lp			Loop structure
+ *
+ *	@return	Start of lexemes, @c -1 on failure
+ */
+static item_t loop_capture(parser *const prs, loop *const lp)
+{
+	const size_t position = in_get_position(prs->io);
+	const location loc = *prs->loc;
+	const size_t texts = strings_size(&lp->texts);
+
+	// Строка уже разобрана на текущей итерации, повторные сообщения не нужны
+	const bool is_recovery_disabled = prs->is_recovery_disabled;
+	const bool was_error = prs->was_error;
+	prs->is_recovery_disabled = true;
+	prs->was_error = true;
+
+	universal_io out = io_create();
+	out_swap(prs->io, &out);
+
+	const size_t record = vector_add(&lp->lexemes, 0);
+	vector_increase(&lp->lexemes, 2);
+
+	size_t amount = 0;
+	char32_t character = '\0';
+	while (character != '\n' && character != (char32_t)EOF)
+	{
+		vector_add(&lp->lexemes, (item_t)in_get_position(prs->io));
+		out_set_buffer(prs->io, MAX_COMMENT_SIZE);
+		character = skip_until(prs, true);
+		vector_add(&lp->lexemes, loop_add_text(lp, out_extract_buffer(prs->io)));
+		vector_add(&lp->lexemes, (item_t)in_get_position(prs->io));
+		vector_add(&lp->lexemes, (item_t)prs->loc->line);
+		vector_add(&lp->lexemes, (item_t)prs->loc->code);
+
+		out_set_buffer(prs->io, MAX_VALUE_SIZE);
+		if (utf8_is_letter(character))
+		{
+			storage_search(prs->stg, prs->io);
+			uni_printf(prs->io, "%s", storage_last_read(prs->stg));
+			vector_add(&lp->lexemes, -1 - loop_add_text(lp, out_extract_buffer(prs->io)));
+		}
+		else if (character == '\'' || character == '"')
+		{
+			uni_print_char(prs->io, uni_scan_char(prs->io));
+			if (skip_string(prs, character) != character)
+			{
+				break;
+			}
+
+			uni_print_char(prs->io, character);
+			vector_add(&lp->lexemes, loop_add_text(lp, out_extract_buffer(prs->io)));
+		}
+		else if (character != '#' && character != (char32_t)EOF)
+		{
+			uni_print_char(prs->io, uni_scan_char(prs->io));
+			vector_add(&lp->lexemes, loop_add_text(lp, out_extract_buffer(prs->io)));
+		}
+		else
+		{
+			break;
+		}
+
+		amount++;
+	}
+
+	out_clear(prs->io);
+	out_swap(prs->io, &out);
+
+	item_t lexemes = -1;
+	if (character == '\n')
+	{
+		lexemes = (item_t)record;
+		vector_set(&lp->lexemes, record, (item_t)amount);
+		vector_set(&lp->lexemes, record + 1, (item_t)in_get_position(prs->io));
+		vector_set(&lp->lexemes, record + 2, (item_t)prs->loc->line);
+	}
+	else
+	{
+		vector_resize(&lp->lexemes, record);
+		while (strings_size(&lp->texts) > texts)
+		{
+			strings_remove(&lp->texts);
+		}
+	}
+
+	prs->was_error = was_error;
+	prs->is_recovery_disabled = is_recovery_disabled;
+	*prs->loc = loc;
+	in_set_position(prs->io, position);
+	return lexemes;
+}
+
+/**
+ *	Output captured usual line.
+ *	Macro identifiers are replaced from input position of lexeme.
+ *	After replacement, continue from the lexeme where input stopped,
+ *	or parse the rest of line, if there is no such lexeme.
+ *
+ *	@param	prs			Parser structure
+ *	@param	lp			Loop structure
+ *	@param	record		Start of lexemes
+ *
+ *	@return	Last read character
+ */
+static char32_t loop_output(parser *const prs, const loop *const lp, const size_t record)
+{
+	const size_t amount = (size_t)vector_get(&lp->lexemes, record);
+	bool has_spaces = true;
+
+	for (size_t i = 0; i < amount; i++)
+	{
+		const size_t lexeme = record + 3 + i * LEXEME_FIELDS;
+		if (has_spaces)
+		{
+			uni_print_str(prs->io, loop_get_text(lp, vector_get(&lp->lexemes, lexeme + LEXEME_SPACES)));
+		}
+
+		has_spaces = true;
+		const item_t text = vector_get(&lp->lexemes, lexeme + LEXEME_TEXT);
+		const char *const value = loop_get_text(lp, text >= 0 ? text : -1 - text);
+		if (text >= 0 || storage_get_index(prs->stg, value) == SIZE_MAX)
+		{
+			uni_print_str(prs->io, value);
+			continue;
+		}
+
+		in_set_position(prs->io, (size_t)vector_get(&lp->lexemes, lexeme + LEXEME_AT));
+		prs->loc->line = (size_t)vector_get(&lp->lexemes, lexeme + LEXEME_LINE);
+		prs->loc->code = (size_t)vector_get(&lp->lexemes, lexeme + LEXEME_CODE);
+		parse_identifier(prs);
+
+		// Замена в файле пропускает пробелы после вызова, в буфере - нет
+		const size_t position = in_get_position(prs->io);
+		size_t next = i + 1;
+		while (next < amount
+			&& (size_t)vector_get(&lp->lexemes, record + 3 + next * LEXEME_FIELDS + LEXEME_FROM) != position
+			&& (size_t)vector_get(&lp->lexemes, record + 3 + next * LEXEME_FIELDS + LEXEME_AT) != position)
+		{
+			next++;
+		}
+
+		if (next == amount)
+		{
+			return parse_until(prs);
+		}
+
+		has_spaces = (size_t)vector_get(&lp->lexemes, record + 3 + next * LEXEME_FIELDS + LEXEME_FROM) == position;
+		i = next - 1;
+	}
+
+	in_set_position(prs->io, (size_t)vector_get(&lp->lexemes, record + 1));
+	prs->loc->line = (size_t)vector_get(&lp->lexemes, record + 2);
+	loc_line_break(prs->loc);
+	return '\n';
+}
+
+/**
+ *	Parse loop body until @c #endw directive.
+ *	Works like @c parse_block, but usual lines are output from the capture,
+ *	once their lexemes and line beginning have been captured.
+ *
+ *	@param	prs			Parser structure
+ *	@param	lp			Loop structure
+ *
+ *	@return	@c KW_ENDW on success, @c NON_KEYWORD on failure
+ */
+static keyword_t loop_parse(parser *const prs, loop *const lp)
+{
+	size_t step = 0;
+	char32_t character = '\0';
+	while (character != (char32_t)EOF)
+	{
+		step = loop_get_step(lp, in_get_position(prs->io), step);
+		const size_t prefix = step + (prs->is_line_required ? STEP_PREFIX_MARK : STEP_PREFIX);
+		item_t lexemes = vector_get(&lp->steps, step + STEP_LEXEMES);
+
+		keyword_t keyword = NON_KEYWORD;
+		if (lexemes > 0 && vector_get(&lp->steps, prefix) != -1)
+		{
+			uni_print_str(prs->io, loop_get_text(lp, vector_get(&lp->steps, prefix)));
+			prs->is_line_required = false;
+		}
+		else if (lexemes != -1)
+		{
+			universal_io out = io_create();
+			out_set_buffer(&out, MAX_COMMENT_SIZE);
+			out_swap(prs->io, &out);
+			keyword = parse_directive(prs);
+			out_swap(prs->io, &out);
+
+			char *buffer = out_extract_buffer(&out);
+			uni_printf(prs->io, "%s", buffer);
+			if (keyword == NON_KEYWORD)
+			{
+				vector_set(&lp->steps, prefix, loop_add_text(lp, buffer));
+				lexemes = lexemes == 0 ? loop_capture(prs, lp) : lexemes;
+			}
+			else
+			{
+				free(buffer);
+				lexemes = -1;
+			}
+
+			vector_set(&lp->steps, step + STEP_LEXEMES, lexemes);
+		}
+		else
+		{
+			keyword = parse_directive(prs);
+		}
+
+		step += STEP_FIELDS;
+		if (lexemes > 0)
+		{
+			character = loop_output(prs, lp, (size_t)lexemes);
+		}
+		else if (!kw_is_end(keyword))
+		{
+			character = parse_keyword(prs, keyword);
+		}
+		else if (!parse_next(prs, KW_WHILE, keyword))
+		{
+			character = skip_directive(prs);
+		}
+		else
+		{
+			return keyword;
+		}
+	}
+
+	return NON_KEYWORD;
+}
+
+/**
+ *	Free captured loop body
+ *
+ *	@param	lp			Loop structure
+ */
+static inline void loop_clear(loop *const lp)
+{
+	vector_clear(&lp->steps);
+	vector_clear(&lp->lexemes);
+	strings_clear(&lp->texts);
+}
+
 /**
  *	Parse @c #while directive.
  *
@@ -2095,15 +2802,21 @@ static inline char32_t parse_while(parser *const prs)
 		return skip_directive(prs);
 	}
 
+	// Условие и директивы тела читаются заново на каждой итерации,
+	// поэтому файл считывается в память один раз до начала итераций
+	in_map_file(prs->io);
+
+	loop lp = loop_create();
 	size_t iteration = 0;
 	const bool was_error = prs->was_error;
 	prs->was_error = prs->is_recovery_disabled && prs->was_error;
 	while (true)
 	{
 		skip_directive(prs);
-		if (parse_block(prs, KW_WHILE) != KW_ENDW)
+		if (loop_parse(prs, &lp) != KW_ENDW)
 		{
 			parser_error(prs, &loc, DIRECTIVE_UNTERMINATED, directive);
+			loop_clear(&lp);
 			return (char32_t)EOF;
 		}
 
@@ -2112,6 +2825,7 @@ static inline char32_t parse_while(parser *const prs)
 		{
 			parser_error(prs, &loc, ITERATION_MAX);
 			parse_extra(prs, storage_last_read(prs->stg));
+			loop_clear(&lp);
 			return skip_directive(prs);
 		}
 
@@ -2126,6 +2840,7 @@ static inline char32_t parse_while(parser *const prs)
 			in_set_position(prs->io, end);
 			parse_extra(prs, storage_last_read(prs->stg));
 			prs->was_error = prs->was_error || was_error;
+			loop_clear(&lp);
 			return skip_directive(prs);
 		}
 	}
@@ -2296,6 +3011,49 @@ static bool parse_next(parser *const prs, const keyword_t begin, const keyword_t
 	return false;
 }
 
+/**
+ *	Parse directive with its block or usual content line.
+ *	End / else tokens are not accepted.
+ *
+ *	@param	prs			Parser structure
+ *	@param	keyword		Recognized keyword
+ *
+ *	@return	Last read character
+ */
+static char32_t parse_keyword(parser *const prs, const keyword_t keyword)
+{
+	switch (keyword)
+	{
+		case KW_LINE:
+			return parse_line(prs);
+		case KW_INCLUDE:
+			return parse_include(prs);
+
+		case KW_DEFINE:
+			return parse_define(prs);
+		case KW_SET:
+			return parse_set(prs);
+		case KW_UNDEF:
+			return parse_undef(prs);
+
+		case KW_MACRO:
+			return parse_macro(prs);
+		case KW_IFDEF:
+		case KW_IFNDEF:
+			return parse_ifdef_ifndef(prs, keyword);
+
+		case KW_IF:
+			return parse_if(prs);
+		case KW_WHILE:
+			return parse_while(prs);
+		case KW_EVAL:
+			return parse_eval(prs);
+
+		default:
+			return parse_until(prs);
+	}
+}
+
 /**
  *	Parse multiline directive block.
  *	Stop at the end / else token if a begin was set.
@@ -2313,54 +3071,17 @@ static keyword_t parse_block(parser *const prs, const keyword_t begin)
 	while (character != (char32_t)EOF)
 	{
 		const keyword_t keyword = parse_directive(prs);
-		switch (keyword)
+		if (!kw_is_end(keyword))
 		{
-			case KW_LINE:
-				character = parse_line(prs);
-				break;
-			case KW_INCLUDE:
-				character = parse_include(prs);
-				break;
-
-			case KW_DEFINE:
-				character = parse_define(prs);
-				break;
-			case KW_SET:
-				character = parse_set(prs);
-				break;
-			case KW_UNDEF:
-				character = parse_undef(prs);
-				break;
-
-			case KW_MACRO:
-				character = parse_macro(prs);
-				break;
-			case KW_IFDEF:
-			case KW_IFNDEF:
-				character = parse_ifdef_ifndef(prs, keyword);
-				break;
-
-			case KW_IF:
-				character = parse_if(prs);
-				break;
-			case KW_WHILE:
-				character = parse_while(prs);
-				break;
-			case KW_EVAL:
-				character = parse_eval(prs);
-				break;
-
-			case NON_KEYWORD:
-			case ERROR_KEYWORD:
-				character = parse_until(prs);
-				break;
-			default:
-				if (!parse_next(prs, begin, keyword))
-				{
-					character = skip_directive(prs);
-					break;
-				}
-				return keyword;
+			character = parse_keyword(prs, keyword);
+		}
+		else if (!parse_next(prs, begin, keyword))
+		{
+			character = skip_directive(prs);
+		}
+		else
+		{
+			return keyword;
 		}
 	}
 
@@ -2396,6 +3117,17 @@ parser parser_create(linker *const lk, storage *const stg, universal_io *const o
 	prs.include = 0;
 	prs.call = 0;
 
+	// Нулевая запись зарезервирована под отсутствие списка замены
+	prs.compiled = vector_create(MAX_CALL_DEPTH);
+	prs.segments = vector_create(MAX_VALUE_SIZE);
+	vector_increase(&prs.segments, 1);
+	prs.literals = strings_create(MAX_CALL_DEPTH);
+	prs.replaced = 0;
+
+	prs.slots = vector_create(MAX_CALL_DEPTH * SLOT_KINDS);
+	prs.values = strings_create(MAX_CALL_DEPTH);
+	prs.marked = 0;
+
 	prs.is_recovery_disabled = false;
 	prs.is_line_required = false;
 	prs.is_macro_processed = false;
@@ -2449,6 +3181,15 @@ bool parser_is_correct(const parser *const prs)
 
 int parser_clear(parser *const prs)
 {
-	(void)prs;
+	if (prs == NULL || !linker_is_correct(prs->lk))
+	{
+		return -1;
+	}
+
+	vector_clear(&prs->compiled);
+	vector_clear(&prs->segments);
+	strings_clear(&prs->literals);
+	vector_clear(&prs->slots);
+	strings_clear(&prs->values);
 	return 0;
 }
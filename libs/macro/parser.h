@@ -21,6 +21,7 @@
 #include "locator.h"
 #include "storage.h"
 #include "uniio.h"
+#include "vector.h"
 
 
 #ifdef __cplusplus
@@ -40,6 +41,15 @@ typedef struct parser
 	size_t include;					/**< Current include depth */
 	size_t call;					/**< Current macro call depth */
 
+	vector compiled;				/**< Start of replacement list by macro index, @c 0 if not compiled */
+	vector segments;				/**< Compiled replacement lists */
+	strings literals;				/**< Literal parts of replacement lists */
+	size_t replaced;				/**< Size of outdated replacement lists in segments */
+
+	vector slots;					/**< Stack of argument frames of macro calls */
+	strings values;					/**< Argument values of macro calls */
+	size_t marked;					/**< Line of the last @c #line mark */
+
 	bool is_recovery_disabled;		/**< Set, if error recovery & multiple output disabled */
 	bool is_line_required;			/**< Set, if position directive required */
 	bool is_macro_processed;		/**< Set, if macro block processed */
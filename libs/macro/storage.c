@@ -46,6 +46,10 @@ static inline size_t add(storage *const stg, const void *const id, size_t (*rese
 
 	const size_t key = reserve(&stg->as, id);
 	const size_t index = hash_add(&stg->hs, (item_t)key, 2);
+	if (index == SIZE_MAX)
+	{
+		return SIZE_MAX;
+	}
 
 	map_set_by_index(&stg->as, key, (item_t)index);
 	hash_set_by_index(&stg->hs, index, 0, ITEM_MAX);
@@ -112,8 +116,12 @@ size_t storage_add_by_io(storage *const stg, universal_io *const io)
 	uni_unscan_char(io, last);
 
 	const size_t index = hash_add(&stg->hs, (item_t)key, 2);
-	map_set_by_index(&stg->as, key, (item_t)index);
+	if (index == SIZE_MAX)
+	{
+		return SIZE_MAX;
+	}
 
+	map_set_by_index(&stg->as, key, (item_t)index);
 	hash_set_by_index(&stg->hs, index, 0, ITEM_MAX);
 	hash_set_by_index(&stg->hs, index, 1, 0);
 	return index;
@@ -0,0 +1,267 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include "arena.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/** Chunk of region */
+struct arena_chunk
+{
+	arena_chunk *prev;			/**< Previous chunk in list */
+	arena_chunk *next;			/**< Next chunk in list of large blocks */
+	size_t size;				/**< Size of chunk data */
+	size_t used;				/**< Used size of chunk data */
+	max_align_t data[];			/**< Chunk data */
+};
+
+
+static const size_t ALIGNMENT = _Alignof(max_align_t);
+static const size_t CHUNK_HEADER = offsetof(arena_chunk, data);
+
+
+static inline size_t align(const size_t size)
+{
+	return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+/**	Large blocks get their own chunk, so that they grow without copying */
+static inline bool is_large(const arena *const ar, const size_t size)
+{
+	return size > ar->chunk_size / 4;
+}
+
+static inline arena_chunk *chunk_from_block(void *const ptr)
+{
+	return (arena_chunk *)((char *)ptr - CHUNK_HEADER);
+}
+
+
+static void *allocate_large(arena *const ar, const size_t size)
+{
+	arena_chunk *const chunk = malloc(CHUNK_HEADER + size);
+	if (chunk == NULL)
+	{
+		return NULL;
+	}
+
+	chunk->prev = NULL;
+	chunk->next = ar->large;
+	chunk->size = size;
+	chunk->used = size;
+
+	if (ar->large != NULL)
+	{
+		ar->large->prev = chunk;
+	}
+
+	ar->large = chunk;
+	ar->chunks++;
+	return chunk->data;
+}
+
+static void *reallocate_large(arena *const ar, void *const ptr, const size_t size)
+{
+	arena_chunk *const chunk = chunk_from_block(ptr);
+	arena_chunk *const prev = chunk->prev;
+	arena_chunk *const next = chunk->next;
+
+	arena_chunk *const chunk_new = realloc(chunk, CHUNK_HEADER + size);
+	if (chunk_new == NULL)
+	{
+		return NULL;
+	}
+
+	chunk_new->size = size;
+	chunk_new->used = size;
+
+	if (prev != NULL)
+	{
+		prev->next = chunk_new;
+	}
+	else
+	{
+		ar->large = chunk_new;
+	}
+
+	if (next != NULL)
+	{
+		next->prev = chunk_new;
+	}
+
+	ar->chunks++;
+	return chunk_new->data;
+}
+
+static void *allocate_small(arena *const ar, const size_t size)
+{
+	arena_chunk *chunk = ar->current;
+	if (chunk == NULL || chunk->size - chunk->used < size)
+	{
+		chunk = malloc(CHUNK_HEADER + ar->chunk_size);
+		if (chunk == NULL)
+		{
+			return NULL;
+		}
+
+		chunk->prev = ar->current;
+		chunk->next = NULL;
+		chunk->size = ar->chunk_size;
+		chunk->used = 0;
+
+		ar->current = chunk;
+		ar->chunks++;
+	}
+
+	void *const ptr = (char *)chunk->data + chunk->used;
+	chunk->used += size;
+	return ptr;
+}
+
+static inline void *allocate(arena *const ar, const size_t size)
+{
+	return is_large(ar, size) ? allocate_large(ar, size) : allocate_small(ar, align(size));
+}
+
+
+/*
+ *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
+ *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
+ *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
+ *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
+ *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+ */
+
+
+arena *arena_create(const size_t chunk_size)
+{
+	arena *const ar = malloc(sizeof(arena));
+	if (ar == NULL)
+	{
+		return NULL;
+	}
+
+	ar->current = NULL;
+	ar->large = NULL;
+	ar->chunk_size = align(chunk_size != 0 ? chunk_size : ARENA_CHUNK_SIZE);
+
+	ar->allocations = 0;
+	ar->chunks = 0;
+	return ar;
+}
+
+
+void *arena_allocate(arena *const ar, const size_t size)
+{
+	if (ar == NULL)
+	{
+		return malloc(size);
+	}
+
+	ar->allocations++;
+	return allocate(ar, size);
+}
+
+void *arena_reallocate(arena *const ar, void *const ptr, const size_t old_size, const size_t new_size)
+{
+	if (ar == NULL)
+	{
+		return realloc(ptr, new_size);
+	}
+
+	if (ptr == NULL)
+	{
+		return arena_allocate(ar, new_size);
+	}
+
+	if (new_size <= old_size)
+	{
+		return ptr;
+	}
+
+	ar->allocations++;
+	if (is_large(ar, old_size))
+	{
+		return reallocate_large(ar, ptr, new_size);
+	}
+
+	// Последний блок текущего куска растёт на месте
+	arena_chunk *const chunk = ar->current;
+	const uintptr_t begin = (uintptr_t)chunk->data;
+	const uintptr_t block = (uintptr_t)ptr;
+	if (!is_large(ar, new_size) && block >= begin && block + align(old_size) == begin + chunk->used
+		&& block + align(new_size) <= begin + chunk->size)
+	{
+		chunk->used = block + align(new_size) - begin;
+		return ptr;
+	}
+
+	void *const ptr_new = allocate(ar, new_size);
+	if (ptr_new != NULL)
+	{
+		memcpy(ptr_new, ptr, old_size);
+	}
+
+	return ptr_new;
+}
+
+void arena_free(arena *const ar, void *const ptr)
+{
+	if (ar == NULL)
+	{
+		free(ptr);
+	}
+}
+
+
+size_t arena_get_allocations(const arena *const ar)
+{
+	return ar != NULL ? ar->allocations : 0;
+}
+
+size_t arena_get_chunks(const arena *const ar)
+{
+	return ar != NULL ? ar->chunks : 0;
+}
+
+
+int arena_clear(arena *const ar)
+{
+	if (ar == NULL)
+	{
+		return -1;
+	}
+
+	while (ar->current != NULL)
+	{
+		arena_chunk *const prev = ar->current->prev;
+		free(ar->current);
+		ar->current = prev;
+	}
+
+	while (ar->large != NULL)
+	{
+		arena_chunk *const next = ar->large->next;
+		free(ar->large);
+		ar->large = next;
+	}
+
+	free(ar);
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "dll.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Default size of region chunk */
+#define ARENA_CHUNK_SIZE (256 * 1024)
+
+
+/** Chunk of region */
+typedef struct arena_chunk arena_chunk;
+
+/** Region allocator */
+typedef struct arena
+{
+	arena_chunk *current;		/**< Chunk for bump allocation */
+	arena_chunk *large;			/**< List of chunks with single large block */
+	size_t chunk_size;			/**< Size of regular chunk */
+
+	size_t allocations;			/**< Number of allocations and growths served by region */
+	size_t chunks;				/**< Number of chunks allocated from system */
+} arena;
+
+
+/**
+ *	Create region
+ *
+ *	@param	chunk_size		Size of regular chunk, @c ARENA_CHUNK_SIZE if @c 0
+ *
+ *	@return	Region, @c NULL on failure
+ */
+EXPORTED arena *arena_create(const size_t chunk_size);
+
+
+/**
+ *	Allocate memory block
+ *
+ *	@param	ar				Region, @c NULL for heap
+ *	@param	size			Size of block
+ *
+ *	@return	Memory block, @c NULL on failure
+ */
+EXPORTED void *arena_allocate(arena *const ar, const size_t size);
+
+/**
+ *	Grow memory block, old contents are kept
+ *
+ *	@param	ar				Region, @c NULL for heap
+ *	@param	ptr				Memory block allocated with the same region
+ *	@param	old_size		Size of block passed on its allocation
+ *	@param	new_size		New size of block
+ *
+ *	@return	Memory block, @c NULL on failure
+ */
+EXPORTED void *arena_reallocate(arena *const ar, void *const ptr, const size_t old_size, const size_t new_size);
+
+/**
+ *	Free memory block, blocks of region are released only with whole region
+ *
+ *	@param	ar				Region, @c NULL for heap
+ *	@param	ptr				Memory block
+ */
+EXPORTED void arena_free(arena *const ar, void *const ptr);
+
+
+/**
+ *	Get number of allocations and growths served by region
+ *
+ *	@param	ar				Region
+ *
+ *	@return	Number of requests
+ */
+EXPORTED size_t arena_get_allocations(const arena *const ar);
+
+/**
+ *	Get number of system allocations made by region for its chunks
+ *
+ *	@param	ar				Region
+ *
+ *	@return	Number of chunks
+ */
+EXPORTED size_t arena_get_chunks(const arena *const ar);
+
+
+/**
+ *	Free region with all allocated blocks
+ *
+ *	@param	ar				Region
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int arena_clear(arena *const ar);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
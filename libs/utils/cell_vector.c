@@ -0,0 +1,141 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include "cell_vector.h"
+#include <string.h>
+
+
+extern size_t cell_vector_size(const cell_vector *const vec);
+extern bool cell_vector_is_correct(const cell_vector *const vec);
+
+extern cell_t cell_vector_at(const cell_vector *const vec, const size_t index);
+extern cell_t *cell_vector_at_mut(cell_vector *const vec, const size_t index);
+extern size_t cell_vector_push_unchecked(cell_vector *const vec, const cell_t value);
+
+extern bool cell_fits_item(const item_t value);
+extern cell_t cell_from_item(const item_t value);
+extern item_t cell_to_item(const cell_t value);
+
+
+static int change_size(cell_vector *const vec, const size_t size)
+{
+	if (size > vec->size_alloc)
+	{
+		const size_t alloc_new = size > 2 * vec->size_alloc ? size : 2 * vec->size_alloc;
+		cell_t *array_new = arena_reallocate(vec->region, vec->array
+			, vec->size_alloc * sizeof(cell_t), alloc_new * sizeof(cell_t));
+		if (array_new == NULL)
+		{
+			return -1;
+		}
+
+		vec->size_alloc = alloc_new;
+		vec->array = array_new;
+	}
+
+	if (size > vec->size)
+	{
+		memset(&vec->array[vec->size], 0, (size - vec->size) * sizeof(cell_t));
+	}
+
+	vec->size = size;
+	return 0;
+}
+
+
+/*
+ *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
+ *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
+ *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
+ *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
+ *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+ */
+
+
+cell_vector cell_vector_create(const size_t alloc)
+{
+	return cell_vector_create_in(NULL, alloc);
+}
+
+cell_vector cell_vector_create_in(arena *const region, const size_t alloc)
+{
+	cell_vector vec;
+
+	vec.size = 0;
+	vec.size_alloc = alloc != 0 ? alloc : 1;
+	vec.region = region;
+	vec.array = arena_allocate(region, vec.size_alloc * sizeof(cell_t));
+
+	return vec;
+}
+
+
+size_t cell_vector_add(cell_vector *const vec, const cell_t value)
+{
+	if (!cell_vector_is_correct(vec) || change_size(vec, vec->size + 1))
+	{
+		return SIZE_MAX;
+	}
+
+	vec->array[vec->size - 1] = value;
+	return vec->size - 1;
+}
+
+int cell_vector_set(cell_vector *const vec, const size_t index, const cell_t value)
+{
+	if (!cell_vector_is_correct(vec) || index >= vec->size)
+	{
+		return -1;
+	}
+
+	vec->array[index] = value;
+	return 0;
+}
+
+cell_t cell_vector_get(const cell_vector *const vec, const size_t index)
+{
+	if (!cell_vector_is_correct(vec) || index >= vec->size)
+	{
+		return CELL_MAX;
+	}
+
+	return vec->array[index];
+}
+
+
+int cell_vector_increase(cell_vector *const vec, const size_t size)
+{
+	return cell_vector_is_correct(vec) ? change_size(vec, vec->size + size) : -1;
+}
+
+int cell_vector_resize(cell_vector *const vec, const size_t size)
+{
+	return cell_vector_is_correct(vec) ? change_size(vec, size) : -1;
+}
+
+
+int cell_vector_clear(cell_vector *const vec)
+{
+	if (!cell_vector_is_correct(vec))
+	{
+		return -1;
+	}
+
+	arena_free(vec->region, vec->array);
+	vec->array = NULL;
+
+	return 0;
+}
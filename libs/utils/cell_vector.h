@@ -0,0 +1,254 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <stdint.h>
+#include "arena.h"
+#include "dll.h"
+#include "item.h"
+
+
+#ifndef CELL
+	#define CELL -32
+#endif
+
+#if CELL >= -32
+	#define CELL_TYPE int32_t
+	#define CELL_MIN INT_MIN
+	#define CELL_MAX INT_MAX
+#else
+	#define CELL_TYPE int64_t
+	#define CELL_MIN LLONG_MIN
+	#define CELL_MAX LLONG_MAX
+#endif
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Cell of internal compiler tables, independent of target item width */
+typedef CELL_TYPE cell_t;
+
+/** Vector of cells */
+typedef struct cell_vector
+{
+	cell_t *array;				/**< Vector array */
+	size_t size;				/**< Size of vector */
+	size_t size_alloc;			/**< Allocated size of vector */
+	arena *region;				/**< Memory region, @c NULL for heap */
+} cell_vector;
+
+
+/**
+ *	Create new cell vector
+ *
+ *	@param	alloc			Initializer of allocated size
+ *
+ *	@return	Cell vector structure
+ */
+EXPORTED cell_vector cell_vector_create(const size_t alloc);
+
+/**
+ *	Create new cell vector in memory region
+ *
+ *	@param	region			Memory region, @c NULL for heap
+ *	@param	alloc			Initializer of allocated size
+ *
+ *	@return	Cell vector structure
+ */
+EXPORTED cell_vector cell_vector_create_in(arena *const region, const size_t alloc);
+
+
+/**
+ *	Add new value
+ *
+ *	@param	vec				Cell vector structure
+ *	@param	value			Value
+ *
+ *	@return	Index, @c SIZE_MAX on failure
+ */
+EXPORTED size_t cell_vector_add(cell_vector *const vec, const cell_t value);
+
+/**
+ *	Set new value
+ *
+ *	@param	vec				Cell vector structure
+ *	@param	index			Index
+ *	@param	value			New value
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int cell_vector_set(cell_vector *const vec, const size_t index, const cell_t value);
+
+/**
+ *	Get value
+ *
+ *	@param	vec				Cell vector structure
+ *	@param	index			Index
+ *
+ *	@return	Value, @c CELL_MAX on failure
+ */
+EXPORTED cell_t cell_vector_get(const cell_vector *const vec, const size_t index);
+
+
+/**
+ *	Increase cell vector size
+ *
+ *	@param	vec				Cell vector structure
+ *	@param	size			Size to increase
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int cell_vector_increase(cell_vector *const vec, const size_t size);
+
+/**
+ *	Change cell vector size
+ *
+ *	@param	vec				Cell vector structure
+ *	@param	size			New vector size
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int cell_vector_resize(cell_vector *const vec, const size_t size);
+
+/**
+ *	Check that cell vector is correct
+ *
+ *	@param	vec				Cell vector structure
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+inline bool cell_vector_is_correct(const cell_vector *const vec)
+{
+	return vec != NULL && vec->array != NULL;
+}
+
+/**
+ *	Get cell vector size
+ *
+ *	@param	vec				Cell vector structure
+ *
+ *	@return	Size of vector, @c SIZE_MAX on failure
+ */
+inline size_t cell_vector_size(const cell_vector *const vec)
+{
+	return cell_vector_is_correct(vec) ? vec->size : SIZE_MAX;
+}
+
+
+/**
+ *	Get value without checks, index must be less than size
+ *
+ *	@param	vec				Cell vector structure
+ *	@param	index			Index
+ *
+ *	@return	Value
+ */
+inline cell_t cell_vector_at(const cell_vector *const vec, const size_t index)
+{
+	assert(cell_vector_is_correct(vec) && index < vec->size);
+	return vec->array[index];
+}
+
+/**
+ *	Get pointer to value without checks, index must be less than size
+ *
+ *	@param	vec				Cell vector structure
+ *	@param	index			Index
+ *
+ *	@return	Pointer to value, valid until the next size change
+ */
+inline cell_t *cell_vector_at_mut(cell_vector *const vec, const size_t index)
+{
+	assert(cell_vector_is_correct(vec) && index < vec->size);
+	return &vec->array[index];
+}
+
+/**
+ *	Add new value to correct cell vector, reallocation is done out of line
+ *
+ *	@param	vec				Cell vector structure
+ *	@param	value			New value
+ *
+ *	@return	Index, @c SIZE_MAX on failure
+ */
+inline size_t cell_vector_push_unchecked(cell_vector *const vec, const cell_t value)
+{
+	assert(cell_vector_is_correct(vec));
+	if (vec->size == vec->size_alloc)
+	{
+		return cell_vector_add(vec, value);
+	}
+
+	vec->array[vec->size] = value;
+	return vec->size++;
+}
+
+
+/**
+ *	Check that item is narrowed to cell without loss,
+ *	cells below @c CELL_MIN / 2 are left for references to wider values
+ *
+ *	@param	value			Item
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+inline bool cell_fits_item(const item_t value)
+{
+	return value >= ITEM_MAX - 1 || ((intmax_t)value >= CELL_MIN / 2 && (intmax_t)value < CELL_MAX - 1);
+}
+
+/**
+ *	Narrow item to cell, @c ITEM_MAX and @c ITEM_MAX - 1 are kept as reserved values
+ *
+ *	@param	value			Item, must fit into cell
+ *
+ *	@return	Cell
+ */
+inline cell_t cell_from_item(const item_t value)
+{
+	assert(cell_fits_item(value));
+	return value >= ITEM_MAX - 1 ? (cell_t)(CELL_MAX - (cell_t)(ITEM_MAX - value)) : (cell_t)value;
+}
+
+/**
+ *	Widen cell to item, @c CELL_MAX and @c CELL_MAX - 1 are kept as reserved values
+ *
+ *	@param	value			Cell
+ *
+ *	@return	Item
+ */
+inline item_t cell_to_item(const cell_t value)
+{
+	return value >= CELL_MAX - 1 ? ITEM_MAX - (item_t)(CELL_MAX - value) : (item_t)value;
+}
+
+
+/**
+ *	Free allocated memory
+ *
+ *	@param	vec				Cell vector structure
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int cell_vector_clear(cell_vector *const vec);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
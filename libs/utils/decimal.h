@@ -0,0 +1,127 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "dll.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of decimal digits which always fit into mantissa */
+#define DECIMAL_MAX_DIGITS 19
+
+
+/** Decimal number as significant digits and power of ten */
+typedef struct decimal
+{
+	uint64_t mantissa;			/**< First significant digits */
+	int64_t exponent;			/**< Power of ten */
+	size_t digits;				/**< Number of digits in mantissa */
+	bool is_truncated;			/**< Set, if some non-zero digits were dropped */
+} decimal;
+
+
+/**
+ *	Create empty decimal number
+ *
+ *	@return	Decimal number
+ */
+inline decimal decimal_create(void)
+{
+	decimal dec = { 0, 0, 0, false };
+	return dec;
+}
+
+/**
+ *	Append digit of integer part
+ *
+ *	@param	dec			Decimal number
+ *	@param	digit		Decimal digit
+ */
+inline void decimal_add_digit(decimal *const dec, const uint8_t digit)
+{
+	if (dec->digits < DECIMAL_MAX_DIGITS)
+	{
+		dec->mantissa = dec->mantissa * 10 + digit;
+		dec->digits += dec->mantissa != 0 ? 1 : 0;
+	}
+	else
+	{
+		dec->exponent++;
+		dec->is_truncated = dec->is_truncated || digit != 0;
+	}
+}
+
+/**
+ *	Append digit of fractional part
+ *
+ *	@param	dec			Decimal number
+ *	@param	digit		Decimal digit
+ */
+inline void decimal_add_fraction(decimal *const dec, const uint8_t digit)
+{
+	if (dec->digits < DECIMAL_MAX_DIGITS)
+	{
+		dec->mantissa = dec->mantissa * 10 + digit;
+		dec->digits += dec->mantissa != 0 ? 1 : 0;
+		dec->exponent--;
+	}
+	else
+	{
+		dec->is_truncated = dec->is_truncated || digit != 0;
+	}
+}
+
+/**
+ *	Append digit of integer with overflow check
+ *
+ *	@param	value		Integer value
+ *	@param	base		Base of integer
+ *	@param	digit		Digit less than base
+ *
+ *	@return	@c 0 on success, @c -1 on overflow
+ */
+inline int decimal_add_integer_digit(uint64_t *const value, const uint8_t base, const uint8_t digit)
+{
+	if (*value > (UINT64_MAX - digit) / base)
+	{
+		return -1;
+	}
+
+	*value = *value * base + digit;
+	return 0;
+}
+
+
+/**
+ *	Convert decimal number to the nearest double
+ *
+ *	@param	dec			Decimal number
+ *	@param	spelling	Number spelling for rare ambiguous cases of truncated numbers, may be @c NULL
+ *
+ *	@return	Correctly rounded double
+ */
+EXPORTED double decimal_to_double(const decimal *const dec, const char *const spelling);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
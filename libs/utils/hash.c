@@ -51,7 +51,12 @@ static inline size_t get_hash(const item_t key)
 
 hash hash_create(const size_t alloc)
 {
-	hash hs = vector_create(MAX_HASH + alloc * (3 + VALUE_SIZE));
+	return hash_create_in(NULL, alloc);
+}
+
+hash hash_create_in(arena *const region, const size_t alloc)
+{
+	hash hs = vector_create_in(region, MAX_HASH + alloc * (3 + VALUE_SIZE));
 	vector_increase(&hs, MAX_HASH);	// All set by zero
 	return hs;
 }
@@ -65,15 +70,15 @@ size_t hash_add(hash *const hs, const item_t key, const size_t amount)
 	}
 
 	size_t prev = get_hash(key);
-	item_t index = vector_get(hs, prev);
+	item_t index = vector_at(hs, prev);
 
 	if (index != 0)
 	{
 		item_t record = ITEM_MAX;
 		while (index != ITEM_MAX && index != 0)
 		{
-			const item_t temp = vector_get(hs, (size_t)index + 1);
-			if (record == ITEM_MAX && temp == ITEM_MAX && (size_t)vector_get(hs, (size_t)index + 2) == amount)
+			const item_t temp = vector_at(hs, (size_t)index + 1);
+			if (record == ITEM_MAX && temp == ITEM_MAX && (size_t)vector_at(hs, (size_t)index + 2) == amount)
 			{
 				record = index;
 			}
@@ -83,7 +88,7 @@ size_t hash_add(hash *const hs, const item_t key, const size_t amount)
 			}
 
 			prev = (size_t)index;
-			index = vector_get(hs, prev);
+			index = vector_at(hs, prev);
 		}
 
 		if (record != ITEM_MAX)
@@ -91,7 +96,7 @@ size_t hash_add(hash *const hs, const item_t key, const size_t amount)
 			index = record;
 			for (size_t i = 0; i < amount; i++)
 			{
-				vector_set(hs, (size_t)index + 3 + i, 0);
+				*vector_at_mut(hs, (size_t)index + 3 + i) = 0;
 			}
 		}
 		else if (index == ITEM_MAX)
@@ -103,12 +108,12 @@ size_t hash_add(hash *const hs, const item_t key, const size_t amount)
 	if (index == 0)
 	{
 		index = (item_t)vector_size(hs);
-		vector_set(hs, prev, index);
+		*vector_at_mut(hs, prev) = index;
 		vector_increase(hs, 3 + amount);	// New elements set by zero
-		vector_set(hs, (size_t)index + 2, (item_t)amount);
+		*vector_at_mut(hs, (size_t)index + 2) = (item_t)amount;
 	}
 
-	vector_set(hs, (size_t)index + 1, key);
+	*vector_at_mut(hs, (size_t)index + 1) = key;
 	return (size_t)index;
 }
 
@@ -121,17 +126,17 @@ size_t hash_get_index(const hash *const hs, const item_t key)
 	}
 
 	size_t prev = get_hash(key);
-	item_t index = vector_get(hs, prev);
+	item_t index = vector_at(hs, prev);
 
 	while (index != ITEM_MAX && index != 0)
 	{
-		if (vector_get(hs, (size_t)index + 1) == key)
+		if (vector_at(hs, (size_t)index + 1) == key)
 		{
 			return (size_t)index;
 		}
 
 		prev = (size_t)index;
-		index = vector_get(hs, prev);
+		index = vector_at(hs, prev);
 	}
 
 	return SIZE_MAX;
@@ -40,6 +40,16 @@ typedef vector hash;
  */
 EXPORTED hash hash_create(const size_t alloc);
 
+/**
+ *	Create new hash table in memory region
+ *
+ *	@param	region			Memory region, @c NULL for heap
+ *	@param	alloc			Initializer of allocated size
+ *
+ *	@return	Hash table
+ */
+EXPORTED hash hash_create_in(arena *const region, const size_t alloc);
+
 
 /**
  *	Add new key
@@ -15,37 +15,83 @@
  */
 
 #include "map.h"
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "uniscanner.h"
 #include "utf8.h"
 
 
+static const uint64_t MAP_FX_SEED = 0x517CC1B727220A95;
+static const size_t MAP_TABLE_MIN = 16;
+
+
 struct map_hash
 {
-	size_t next;
-	size_t ref;
-	item_t value;
+	size_t ref;					/**< Key offset in keys storage */
+	size_t length;				/**< Key length */
+	size_t hash;				/**< Key hash */
+	item_t value;				/**< Value */
 };
 
 
-static int map_add_key_symbol(map *const as, const char32_t ch)
+static int map_keys_reserve(map *const as, const size_t size)
 {
-	if (MAX_SYMBOL_SIZE <= as->keys_alloc - as->keys_next)
+	while (as->keys_alloc - as->keys_next < size)
 	{
-		as->keys_next += utf8_to_string(&as->keys[as->keys_next], ch);
-		return 0;
+		char *keys_new = arena_reallocate(as->region, as->keys
+			, as->keys_alloc * sizeof(char), 2 * as->keys_alloc * sizeof(char));
+		if (keys_new == NULL)
+		{
+			return -1;
+		}
+
+		as->keys_alloc *= 2;
+		as->keys = keys_new;
 	}
 
-	char *keys_new = realloc(as->keys, 2 * as->keys_alloc * sizeof(char));
-	if (keys_new == NULL)
+	return 0;
+}
+
+static inline int map_add_key_symbol(map *const as, const char32_t ch)
+{
+	if (map_keys_reserve(as, MAX_SYMBOL_SIZE))
 	{
 		return -1;
 	}
 
-	as->keys_alloc *= 2;
-	as->keys = keys_new;
-	return map_add_key_symbol(as, ch);
+	as->keys_next += utf8_to_string(&as->keys[as->keys_next], ch);
+	return 0;
+}
+
+/**
+ *	FxHash of the last read key with final mixing, because table slot is taken from low bits
+ */
+static size_t map_hash_key(const map *const as)
+{
+	const char *const key = &as->keys[as->keys_size];
+	const size_t length = as->keys_next - as->keys_size;
+
+	uint64_t hash = 0;
+	size_t i = 0;
+	for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, &key[i], sizeof(uint64_t));
+		hash = (((hash << 5) | (hash >> 59)) ^ word) * MAP_FX_SEED;
+	}
+
+	for (; i < length; i++)
+	{
+		hash = (((hash << 5) | (hash >> 59)) ^ (uint8_t)key[i]) * MAP_FX_SEED;
+	}
+
+	hash ^= hash >> 32;
+	hash *= MAP_FX_SEED;
+	hash ^= hash >> 29;
+
+	// SIZE_MAX is reserved for failure
+	return (size_t)hash != SIZE_MAX ? (size_t)hash : 0;
 }
 
 static size_t map_get_hash(map *const as, const char *const key)
@@ -57,25 +103,16 @@ static size_t map_get_hash(map *const as, const char *const key)
 
 	as->keys_next = as->keys_size;
 
-	char32_t ch = utf8_convert(key);
-	if (map_add_key_symbol(as, ch))
+	const size_t length = strlen(key);
+	if (map_keys_reserve(as, length + 1))
 	{
 		return SIZE_MAX;
 	}
 
-	size_t hash = ch;
-	while (key[as->keys_next - as->keys_size] != '\0')
-	{
-		ch = utf8_convert(&key[as->keys_next - as->keys_size]);
-		if (map_add_key_symbol(as, ch))
-		{
-			return SIZE_MAX;
-		}
-
-		hash += ch;
-	}
+	memcpy(&as->keys[as->keys_size], key, length + 1);
+	as->keys_next += length;
 
-	return hash % MAP_HASH_MAX;
+	return map_hash_key(as);
 }
 
 static size_t map_get_hash_by_utf8(map *const as, const char32_t *const key)
@@ -87,18 +124,15 @@ static size_t map_get_hash_by_utf8(map *const as, const char32_t *const key)
 
 	as->keys_next = as->keys_size;
 
-	size_t hash = 0;
 	for (size_t i = 0; key[i] != '\0'; i++)
 	{
 		if (map_add_key_symbol(as, key[i]))
 		{
 			return SIZE_MAX;
 		}
-
-		hash += key[i];
 	}
 
-	return hash % MAP_HASH_MAX;
+	return map_hash_key(as);
 }
 
 static size_t map_get_hash_by_io(map *const as, universal_io *const io, char32_t *const last)
@@ -116,56 +150,79 @@ static size_t map_get_hash_by_io(map *const as, universal_io *const io, char32_t
 		return SIZE_MAX;
 	}
 
-	if (map_add_key_symbol(as, *last))
-	{
-		return SIZE_MAX;
-	}
-
-	size_t hash = *last;
-	*last = uni_scan_char(io);
-	while (utf8_is_letter(*last) || utf8_is_digit(*last))
+	do
 	{
 		if (map_add_key_symbol(as, *last))
 		{
 			return SIZE_MAX;
 		}
 
-		hash += *last;
 		*last = uni_scan_char(io);
-	}
+	} while (utf8_is_letter(*last) || utf8_is_digit(*last));
 
-	return hash % MAP_HASH_MAX;
+	return map_hash_key(as);
 }
 
 
-static inline int map_cmp_key(const map *const as, const size_t index)
+static size_t map_find_slot(const map *const as, const size_t hash)
 {
-	return strcmp(&as->keys[as->values[index].ref], &as->keys[as->keys_size]);
+	const char *const key = &as->keys[as->keys_size];
+	const size_t length = as->keys_next - as->keys_size;
+	const size_t mask = as->table_size - 1;
+
+	size_t slot = hash & mask;
+	while (as->table[slot] != 0)
+	{
+		// Сравнение строк только при совпадении хеша и длины
+		const map_hash *const record = &as->values[as->table[slot] - 1];
+		if (record->hash == hash && record->length == length && memcmp(&as->keys[record->ref], key, length) == 0)
+		{
+			return slot;
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	return slot;
 }
 
-static inline size_t map_get_index_by_hash(const map *const as, const size_t hash)
+static int map_grow_table(map *const as)
 {
-	if (hash == SIZE_MAX)
+	const size_t size = 2 * as->table_size;
+	size_t *table = arena_allocate(as->region, size * sizeof(size_t));
+	if (table == NULL)
 	{
-		return SIZE_MAX;
+		return -1;
 	}
 
-	size_t index = hash;
-	while (as->values[index].next != SIZE_MAX)
+	memset(table, 0, size * sizeof(size_t));
+
+	for (size_t i = 0; i < as->values_size; i++)
 	{
-		if (map_cmp_key(as, index) == 0)
+		size_t slot = as->values[i].hash & (size - 1);
+		while (table[slot] != 0)
 		{
-			return index;
+			slot = (slot + 1) & (size - 1);
 		}
-		index = as->values[index].next;
+
+		table[slot] = i + 1;
 	}
 
-	if (as->values[index].ref == SIZE_MAX || map_cmp_key(as, index) != 0)
+	arena_free(as->region, as->table);
+	as->table = table;
+	as->table_size = size;
+	return 0;
+}
+
+static inline size_t map_get_index_by_hash(const map *const as, const size_t hash)
+{
+	if (hash == SIZE_MAX)
 	{
 		return SIZE_MAX;
 	}
 
-	return index;
+	const size_t slot = map_find_slot(as, hash);
+	return as->table[slot] != 0 ? as->table[slot] - 1 : SIZE_MAX;
 }
 
 static size_t map_add_by_hash(map *const as, const size_t hash, const item_t value)
@@ -175,31 +232,16 @@ static size_t map_add_by_hash(map *const as, const size_t hash, const item_t val
 		return SIZE_MAX;
 	}
 
-	size_t index = hash;
-	while (as->values[index].next != SIZE_MAX)
-	{
-		if (map_cmp_key(as, index) == 0)
-		{
-			return value == ITEM_MAX ? index : SIZE_MAX;
-		}
-		index = as->values[index].next;
-	}
-
-	if (as->values[index].ref == SIZE_MAX)
+	size_t slot = map_find_slot(as, hash);
+	if (as->table[slot] != 0)
 	{
-		as->values[index].ref = as->keys_size;
-		as->keys_size = as->keys_next + 1;
-		as->values[index].value = value;
-		return index;
-	}
-	else if (map_cmp_key(as, index) == 0)
-	{
-		return value == ITEM_MAX ? index : SIZE_MAX;
+		return value == ITEM_MAX ? as->table[slot] - 1 : SIZE_MAX;
 	}
 
 	if (as->values_size == as->values_alloc)
 	{
-		map_hash *values_new = realloc(as->values, 2 * as->values_alloc * sizeof(map_hash));
+		map_hash *values_new = arena_reallocate(as->region, as->values
+			, as->values_alloc * sizeof(map_hash), 2 * as->values_alloc * sizeof(map_hash));
 		if (values_new == NULL)
 		{
 			return SIZE_MAX;
@@ -209,13 +251,24 @@ static size_t map_add_by_hash(map *const as, const size_t hash, const item_t val
 		as->values = values_new;
 	}
 
-	as->values[index].next = as->values_size;
-	index = as->values_size++;
+	if ((as->values_size + 1) * 100 > as->table_size * MAP_LOAD_FACTOR)
+	{
+		if (map_grow_table(as))
+		{
+			return SIZE_MAX;
+		}
+
+		slot = map_find_slot(as, hash);
+	}
 
-	as->values[index].next = SIZE_MAX;
+	const size_t index = as->values_size++;
 	as->values[index].ref = as->keys_size;
-	as->keys_size = as->keys_next + 1;
+	as->values[index].length = as->keys_next - as->keys_size;
+	as->values[index].hash = hash;
 	as->values[index].value = value;
+
+	as->keys_size = as->keys_next + 1;
+	as->table[slot] = index + 1;
 	return index;
 }
 
@@ -246,8 +299,10 @@ static item_t map_get_by_hash(const map *const as, const size_t hash)
 static inline map map_broken()
 {
 	map as;
+	as.region = NULL;
 	as.values = NULL;
 	as.keys = NULL;
+	as.table = NULL;
 	return as;
 }
 
@@ -262,31 +317,48 @@ static inline map map_broken()
 
 
 map map_create(const size_t alloc)
+{
+	return map_create_in(NULL, alloc);
+}
+
+map map_create_in(arena *const region, const size_t alloc)
 {
 	map as;
+	as.region = region;
 
-	as.values_size = MAP_HASH_MAX;
-	as.values_alloc = as.values_size + alloc;
+	as.values_size = 0;
+	as.values_alloc = alloc != 0 ? alloc : 1;
 
-	as.values = malloc(as.values_alloc * sizeof(map_hash));
+	as.values = arena_allocate(region, as.values_alloc * sizeof(map_hash));
 	if (as.values == NULL)
 	{
 		return map_broken();
 	}
 
-	for (size_t i = 0; i < as.values_size; i++)
+	as.table_size = MAP_TABLE_MIN;
+	while (as.table_size * MAP_LOAD_FACTOR < as.values_alloc * 100)
+	{
+		as.table_size *= 2;
+	}
+
+	as.table = arena_allocate(region, as.table_size * sizeof(size_t));
+	if (as.table == NULL)
 	{
-		as.values[i].next = SIZE_MAX;
-		as.values[i].ref = SIZE_MAX;
+		arena_free(region, as.values);
+		return map_broken();
 	}
 
+	memset(as.table, 0, as.table_size * sizeof(size_t));
+
 	as.keys_size = 0;
+	as.keys_next = 0;
 	as.keys_alloc = as.values_alloc * MAP_KEY_SIZE;
 
-	as.keys = malloc(as.keys_alloc * sizeof(char));
+	as.keys = arena_allocate(region, as.keys_alloc * sizeof(char));
 	if (as.keys == NULL)
 	{
-		free(as.values);
+		arena_free(region, as.values);
+		arena_free(region, as.table);
 		return map_broken();
 	}
 
@@ -343,7 +415,7 @@ size_t map_set_by_io(map *const as, universal_io *const io, const item_t value,
 
 int map_set_by_index(map *const as, const size_t index, const item_t value)
 {
-	if (!map_is_correct(as) || index >= as->values_size || as->values[index].ref == SIZE_MAX)
+	if (!map_is_correct(as) || index >= as->values_size)
 	{
 		return -1;
 	}
@@ -386,7 +458,7 @@ item_t map_get_by_io(map *const as, universal_io *const io, char32_t *const last
 
 item_t map_get_by_index(const map *const as, const size_t index)
 {
-	return map_is_correct(as) && index < as->values_size && as->values[index].ref != SIZE_MAX
+	return map_is_correct(as) && index < as->values_size
 		? as->values[index].value
 		: ITEM_MAX;
 }
@@ -394,7 +466,7 @@ item_t map_get_by_index(const map *const as, const size_t index)
 
 const char *map_to_string(const map *const as, const size_t index)
 {
-	return map_is_correct(as) && index < as->values_size && as->values[index].ref != SIZE_MAX
+	return map_is_correct(as) && index < as->values_size
 		? &as->keys[as->values[index].ref]
 		: NULL;
 }
@@ -406,7 +478,7 @@ const char *map_last_read(const map *const as)
 
 bool map_is_correct(const map *const as)
 {
-	return as != NULL && as->values != NULL && as->keys != NULL;
+	return as != NULL && as->values != NULL && as->keys != NULL && as->table != NULL;
 }
 
 
@@ -417,11 +489,14 @@ int map_clear(map *const as)
 		return -1;
 	}
 
-	free(as->values);
+	arena_free(as->region, as->values);
 	as->values = NULL;
 
-	free(as->keys);
+	arena_free(as->region, as->keys);
 	as->keys = NULL;
 
+	arena_free(as->region, as->table);
+	as->table = NULL;
+
 	return 0;
 }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "arena.h"
 #include "dll.h"
 #include "item.h"
 #include "uniio.h"
@@ -25,11 +26,11 @@
 extern "C" {
 #endif
 
-static const size_t MAP_HASH_MAX = 256;
+static const size_t MAP_LOAD_FACTOR = 75;
 static const size_t MAP_KEY_SIZE = 8;
 
 
-/** Hash table */
+/** Record of key */
 typedef struct map_hash map_hash;
 
 /** Associative array (Dictionary) */
@@ -43,6 +44,11 @@ typedef struct map
 	map_hash *values;			/**< Values storage */
 	size_t values_size;			/**< Size of values storage */
 	size_t values_alloc;		/**< Allocated size of values storage */
+
+	size_t *table;				/**< Open addressing table of record indices */
+	size_t table_size;			/**< Size of table, power of two */
+
+	arena *region;				/**< Memory region, @c NULL for heap */
 } map;
 
 
@@ -55,6 +61,16 @@ typedef struct map
  */
 EXPORTED map map_create(const size_t alloc);
 
+/**
+ *	Create map structure in memory region
+ *
+ *	@param	region			Memory region, @c NULL for heap
+ *	@param	alloc			Initializer of allocated size
+ *
+ *	@return	Map structure
+ */
+EXPORTED map map_create_in(arena *const region, const size_t alloc);
+
 
 /**
  *	Reserve new key or return existing
@@ -29,7 +29,7 @@ extern "C" {
 /** Node vector structure */
 typedef struct node_vector
 {
-	vector *tree;			/**< Tree */
+	node_tree *tree;		/**< Tree */
 	vector nodes;			/**< Nodes in AST */
 } node_vector;
 
@@ -107,7 +107,7 @@ inline size_t node_vector_size(const node_vector *const vec)
  */
 inline bool node_vector_is_correct(const node_vector *const vec)
 {
-	return vec != NULL && vector_is_correct(vec->tree) && vector_is_correct(&vec->nodes);
+	return vec != NULL && node_tree_is_correct(vec->tree) && vector_is_correct(&vec->nodes);
 }
 
 /**
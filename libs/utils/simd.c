@@ -0,0 +1,301 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include "simd.h"
+#include <stdbool.h>
+#include <string.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(_WIN32)
+	#include <immintrin.h>
+
+	#define SIMD_X86
+#endif
+
+
+static simd_level level = SIMD_NONE;
+static bool is_detected = false;
+
+
+static inline bool is_blank(const char byte)
+{
+	return byte == ' ' || byte == '\t' || byte == '\n' || byte == '\r';
+}
+
+static simd_level detect_level(void)
+{
+#ifdef SIMD_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return SIMD_AVX2;
+	}
+
+	if (__builtin_cpu_supports("sse2"))
+	{
+		return SIMD_SSE2;
+	}
+#endif
+
+	return SIMD_SCALAR;
+}
+
+static inline simd_level current_level(void)
+{
+	if (!is_detected)
+	{
+		level = detect_level();
+		is_detected = true;
+	}
+
+	return level;
+}
+
+
+static size_t skip_blank_scalar(const char *const str, const size_t size)
+{
+	size_t i = 0;
+	while (i < size && is_blank(str[i]))
+	{
+		i++;
+	}
+
+	return i;
+}
+
+static size_t find_byte_scalar(const char *const str, const size_t size, const char byte)
+{
+	const char *const found = memchr(str, byte, size);
+	return found != NULL ? (size_t)(found - str) : size;
+}
+
+static size_t find_pair_scalar(const char *const str, const size_t size, const char fst, const char snd)
+{
+	for (size_t i = 0; i + 1 < size; i++)
+	{
+		i += find_byte_scalar(&str[i], size - 1 - i, fst);
+		if (i + 1 < size && str[i + 1] == snd)
+		{
+			return i;
+		}
+	}
+
+	return size;
+}
+
+
+#ifdef SIMD_X86
+
+__attribute__((target("sse2"))) static inline __m128i blank_mask_sse2(const __m128i block)
+{
+	return _mm_or_si128(
+		_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'))),
+		_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\r'))));
+}
+
+__attribute__((target("sse2"))) static size_t skip_blank_sse2(const char *const str, const size_t size)
+{
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16)
+	{
+		const __m128i block = _mm_loadu_si128((const __m128i *)&str[i]);
+		const unsigned int mask = ~(unsigned int)_mm_movemask_epi8(blank_mask_sse2(block)) & 0xFFFF;
+		if (mask != 0)
+		{
+			return i + (size_t)__builtin_ctz(mask);
+		}
+	}
+
+	return i + skip_blank_scalar(&str[i], size - i);
+}
+
+__attribute__((target("sse2"))) static size_t find_byte_sse2(const char *const str, const size_t size, const char byte)
+{
+	const __m128i pattern = _mm_set1_epi8(byte);
+
+	size_t i = 0;
+	for (; i + 16 <= size; i += 16)
+	{
+		const __m128i block = _mm_loadu_si128((const __m128i *)&str[i]);
+		const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern));
+		if (mask != 0)
+		{
+			return i + (size_t)__builtin_ctz(mask);
+		}
+	}
+
+	return i + find_byte_scalar(&str[i], size - i, byte);
+}
+
+__attribute__((target("sse2"))) static size_t find_pair_sse2(const char *const str, const size_t size
+	, const char fst, const char snd)
+{
+	const __m128i fst_pattern = _mm_set1_epi8(fst);
+	const __m128i snd_pattern = _mm_set1_epi8(snd);
+
+	size_t i = 0;
+	for (; i + 17 <= size; i += 16)
+	{
+		const __m128i fst_block = _mm_loadu_si128((const __m128i *)&str[i]);
+		const __m128i snd_block = _mm_loadu_si128((const __m128i *)&str[i + 1]);
+		const unsigned int mask = (unsigned int)_mm_movemask_epi8(
+			_mm_and_si128(_mm_cmpeq_epi8(fst_block, fst_pattern), _mm_cmpeq_epi8(snd_block, snd_pattern)));
+		if (mask != 0)
+		{
+			return i + (size_t)__builtin_ctz(mask);
+		}
+	}
+
+	return i + find_pair_scalar(&str[i], size - i, fst, snd);
+}
+
+
+__attribute__((target("avx2"))) static inline __m256i blank_mask_avx2(const __m256i block)
+{
+	return _mm256_or_si256(
+		_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\t'))),
+		_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\r'))));
+}
+
+__attribute__((target("avx2"))) static size_t skip_blank_avx2(const char *const str, const size_t size)
+{
+	size_t i = 0;
+	for (; i + 32 <= size; i += 32)
+	{
+		const __m256i block = _mm256_loadu_si256((const __m256i *)&str[i]);
+		const unsigned int mask = ~(unsigned int)_mm256_movemask_epi8(blank_mask_avx2(block));
+		if (mask != 0)
+		{
+			return i + (size_t)__builtin_ctz(mask);
+		}
+	}
+
+	return i + skip_blank_sse2(&str[i], size - i);
+}
+
+__attribute__((target("avx2"))) static size_t find_byte_avx2(const char *const str, const size_t size, const char byte)
+{
+	const __m256i pattern = _mm256_set1_epi8(byte);
+
+	size_t i = 0;
+	for (; i + 32 <= size; i += 32)
+	{
+		const __m256i block = _mm256_loadu_si256((const __m256i *)&str[i]);
+		const unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern));
+		if (mask != 0)
+		{
+			return i + (size_t)__builtin_ctz(mask);
+		}
+	}
+
+	return i + find_byte_sse2(&str[i], size - i, byte);
+}
+
+__attribute__((target("avx2"))) static size_t find_pair_avx2(const char *const str, const size_t size
+	, const char fst, const char snd)
+{
+	const __m256i fst_pattern = _mm256_set1_epi8(fst);
+	const __m256i snd_pattern = _mm256_set1_epi8(snd);
+
+	size_t i = 0;
+	for (; i + 33 <= size; i += 32)
+	{
+		const __m256i fst_block = _mm256_loadu_si256((const __m256i *)&str[i]);
+		const __m256i snd_block = _mm256_loadu_si256((const __m256i *)&str[i + 1]);
+		const unsigned int mask = (unsigned int)_mm256_movemask_epi8(
+			_mm256_and_si256(_mm256_cmpeq_epi8(fst_block, fst_pattern), _mm256_cmpeq_epi8(snd_block, snd_pattern)));
+		if (mask != 0)
+		{
+			return i + (size_t)__builtin_ctz(mask);
+		}
+	}
+
+	return i + find_pair_sse2(&str[i], size - i, fst, snd);
+}
+
+#endif
+
+
+/*
+ *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
+ *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
+ *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
+ *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
+ *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+ */
+
+
+simd_level simd_get_level(void)
+{
+	return current_level();
+}
+
+int simd_set_level(const simd_level new_level)
+{
+	if (new_level > detect_level())
+	{
+		return -1;
+	}
+
+	level = new_level;
+	is_detected = true;
+	return 0;
+}
+
+
+size_t simd_skip_blank(const char *const str, const size_t size)
+{
+	switch (current_level())
+	{
+#ifdef SIMD_X86
+		case SIMD_AVX2:
+			return skip_blank_avx2(str, size);
+		case SIMD_SSE2:
+			return skip_blank_sse2(str, size);
+#endif
+		default:
+			return skip_blank_scalar(str, size);
+	}
+}
+
+size_t simd_find_byte(const char *const str, const size_t size, const char byte)
+{
+	switch (current_level())
+	{
+#ifdef SIMD_X86
+		case SIMD_AVX2:
+			return find_byte_avx2(str, size, byte);
+		case SIMD_SSE2:
+			return find_byte_sse2(str, size, byte);
+#endif
+		default:
+			return find_byte_scalar(str, size, byte);
+	}
+}
+
+size_t simd_find_pair(const char *const str, const size_t size, const char fst, const char snd)
+{
+	switch (current_level())
+	{
+#ifdef SIMD_X86
+		case SIMD_AVX2:
+			return find_pair_avx2(str, size, fst, snd);
+		case SIMD_SSE2:
+			return find_pair_sse2(str, size, fst, snd);
+#endif
+		default:
+			return find_pair_scalar(str, size, fst, snd);
+	}
+}
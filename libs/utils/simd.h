@@ -0,0 +1,89 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "dll.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Instruction set used by block search */
+typedef enum SIMD_LEVEL
+{
+	SIMD_NONE,					/**< Block search disabled */
+	SIMD_SCALAR,				/**< Portable scalar implementation */
+	SIMD_SSE2,					/**< 16 bytes per step */
+	SIMD_AVX2,					/**< 32 bytes per step */
+} simd_level;
+
+
+/**
+ *	Get instruction set used by block search
+ *
+ *	@return	Current level, by default the best one supported by CPU
+ */
+EXPORTED simd_level simd_get_level(void);
+
+/**
+ *	Set instruction set used by block search
+ *
+ *	@param	level		New level
+ *
+ *	@return	@c 0 on success, @c -1 if level is not supported by CPU
+ */
+EXPORTED int simd_set_level(const simd_level level);
+
+
+/**
+ *	Find first byte which is not space, tab or newline
+ *
+ *	@param	str			Byte string
+ *	@param	size		Size of string
+ *
+ *	@return	Index of found byte, @c size if not found
+ */
+EXPORTED size_t simd_skip_blank(const char *const str, const size_t size);
+
+/**
+ *	Find first occurrence of byte
+ *
+ *	@param	str			Byte string
+ *	@param	size		Size of string
+ *	@param	byte		Byte to find
+ *
+ *	@return	Index of found byte, @c size if not found
+ */
+EXPORTED size_t simd_find_byte(const char *const str, const size_t size, const char byte);
+
+/**
+ *	Find first occurrence of two consecutive bytes
+ *
+ *	@param	str			Byte string
+ *	@param	size		Size of string
+ *	@param	fst			First byte of pair
+ *	@param	snd			Second byte of pair
+ *
+ *	@return	Index of first byte of found pair, @c size if not found
+ */
+EXPORTED size_t simd_find_pair(const char *const str, const size_t size, const char fst, const char snd);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,347 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include "stream.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+	#include <pthread.h>
+	#include <stdatomic.h>
+
+	typedef atomic_size_t counter_t;
+	typedef atomic_bool flag_t;
+
+	#define counter_load(counter) atomic_load_explicit(counter, memory_order_acquire)
+	#define counter_store(counter, value) atomic_store_explicit(counter, value, memory_order_release)
+#else
+	// Без потоков очередь используется из одного потока, атомарность не нужна
+	typedef size_t counter_t;
+	typedef bool flag_t;
+
+	#define counter_load(counter) (*(counter))
+	#define counter_store(counter, value) (*(counter) = (value))
+#endif
+
+
+static const size_t SPIN_LIMIT = 256;
+
+
+/*
+ *	Кольцо из capacity чанков, head и tail только растут:
+ *		чанки [head, tail) опубликованы производителем и ещё не прочитаны,
+ *		чанк tail заполняется производителем, если tail - head < capacity
+ */
+struct stream
+{
+	char *chunks;				/**< Chunks storage */
+	size_t *sizes;				/**< Sizes of published chunks */
+
+	size_t chunk_size;			/**< Size of one chunk */
+	size_t capacity;			/**< Number of chunks */
+	size_t filled;				/**< Filled size of current chunk, producer only */
+
+	counter_t head;				/**< Number of chunks read by consumer */
+	counter_t tail;				/**< Number of chunks published by producer */
+
+	flag_t is_closed;			/**< Set by producer after the last chunk */
+	flag_t is_failed;			/**< Set by producer when the text is incomplete */
+	flag_t is_cancelled;		/**< Set by consumer when the rest is not needed */
+
+#ifndef _WIN32
+	pthread_mutex_t mutex;		/**< Mutex of blocking wait */
+	pthread_cond_t changed;		/**< Signalled when counters or flags are changed */
+	counter_t waiting;			/**< Number of sides in blocking wait */
+#endif
+};
+
+/** Condition of waiting for the other side */
+typedef bool (*condition)(stream *const strm, const size_t counter);
+
+
+static bool has_free_chunk(stream *const strm, const size_t tail)
+{
+	return tail - counter_load(&strm->head) != strm->capacity || counter_load(&strm->is_cancelled);
+}
+
+static bool has_published_chunk(stream *const strm, const size_t head)
+{
+	return head != counter_load(&strm->tail) || counter_load(&strm->is_closed);
+}
+
+/** Wait until condition holds, short spinning goes before blocking */
+static void stream_wait(stream *const strm, const condition cond, const size_t counter)
+{
+	// Другая сторона обычно продвигается быстрее, чем поток засыпает и просыпается
+	for (size_t i = 0; i < SPIN_LIMIT; i++)
+	{
+		if (cond(strm, counter))
+		{
+			return;
+		}
+	}
+
+#ifndef _WIN32
+	pthread_mutex_lock(&strm->mutex);
+	atomic_fetch_add(&strm->waiting, 1);
+
+	// Парный барьер в stream_notify: либо условие уже выполнено, либо ожидающий будет разбужен
+	atomic_thread_fence(memory_order_seq_cst);
+	while (!cond(strm, counter))
+	{
+		pthread_cond_wait(&strm->changed, &strm->mutex);
+	}
+
+	atomic_fetch_sub(&strm->waiting, 1);
+	pthread_mutex_unlock(&strm->mutex);
+#else
+	while (!cond(strm, counter));
+#endif
+}
+
+/** Wake up the other side after change of counters or flags */
+static void stream_notify(stream *const strm)
+{
+#ifndef _WIN32
+	atomic_thread_fence(memory_order_seq_cst);
+	if (atomic_load_explicit(&strm->waiting, memory_order_relaxed) != 0)
+	{
+		pthread_mutex_lock(&strm->mutex);
+		pthread_cond_broadcast(&strm->changed);
+		pthread_mutex_unlock(&strm->mutex);
+	}
+#else
+	(void)strm;
+#endif
+}
+
+
+/** Wait for free chunk, @c -1 if stream was cancelled */
+static inline int stream_reserve(stream *const strm, const size_t tail)
+{
+	stream_wait(strm, &has_free_chunk, tail);
+	return counter_load(&strm->is_cancelled) ? -1 : 0;
+}
+
+/** Publish current chunk */
+static inline void stream_publish(stream *const strm)
+{
+	const size_t tail = counter_load(&strm->tail);
+	strm->sizes[tail % strm->capacity] = strm->filled;
+	strm->filled = 0;
+
+	counter_store(&strm->tail, tail + 1);
+	stream_notify(strm);
+}
+
+
+/*
+ *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
+ *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
+ *	\ \ \  \ \ \-.  \  \/_/\ \/ \ \  __\   \ \  __<   \ \  __\ \ \  __ \  \ \ \____  \ \  __\
+ *	 \ \_\  \ \_\\"\_\    \ \_\  \ \_____\  \ \_\ \_\  \ \_\    \ \_\ \_\  \ \_____\  \ \_____\
+ *	  \/_/   \/_/ \/_/     \/_/   \/_____/   \/_/ /_/   \/_/     \/_/\/_/   \/_____/   \/_____/
+ */
+
+
+stream *stream_create(const size_t chunk_size, const size_t capacity)
+{
+	if (chunk_size == 0 || capacity == 0)
+	{
+		return NULL;
+	}
+
+	stream *const strm = malloc(sizeof(stream));
+	if (strm == NULL)
+	{
+		return NULL;
+	}
+
+	strm->chunks = malloc(chunk_size * capacity * sizeof(char));
+	strm->sizes = malloc(capacity * sizeof(size_t));
+	if (strm->chunks == NULL || strm->sizes == NULL)
+	{
+		free(strm->chunks);
+		free(strm->sizes);
+		free(strm);
+		return NULL;
+	}
+
+	strm->chunk_size = chunk_size;
+	strm->capacity = capacity;
+	strm->filled = 0;
+
+	counter_store(&strm->head, 0);
+	counter_store(&strm->tail, 0);
+
+	counter_store(&strm->is_closed, false);
+	counter_store(&strm->is_failed, false);
+	counter_store(&strm->is_cancelled, false);
+
+#ifndef _WIN32
+	counter_store(&strm->waiting, 0);
+	if (pthread_mutex_init(&strm->mutex, NULL) != 0)
+	{
+		free(strm->chunks);
+		free(strm->sizes);
+		free(strm);
+		return NULL;
+	}
+
+	if (pthread_cond_init(&strm->changed, NULL) != 0)
+	{
+		pthread_mutex_destroy(&strm->mutex);
+		free(strm->chunks);
+		free(strm->sizes);
+		free(strm);
+		return NULL;
+	}
+#endif
+
+	return strm;
+}
+
+
+int stream_write(stream *const strm, const char *const data, const size_t size)
+{
+	if (strm == NULL || data == NULL)
+	{
+		return -1;
+	}
+
+	size_t written = 0;
+	while (written < size)
+	{
+		const size_t tail = counter_load(&strm->tail);
+		if (strm->filled == 0 && stream_reserve(strm, tail))
+		{
+			return -1;
+		}
+
+		const size_t rest = strm->chunk_size - strm->filled;
+		const size_t part = size - written < rest ? size - written : rest;
+		memcpy(&strm->chunks[(tail % strm->capacity) * strm->chunk_size + strm->filled], &data[written], part);
+
+		strm->filled += part;
+		written += part;
+
+		if (strm->filled == strm->chunk_size)
+		{
+			stream_publish(strm);
+		}
+	}
+
+	return 0;
+}
+
+int stream_close(stream *const strm)
+{
+	if (strm == NULL)
+	{
+		return -1;
+	}
+
+	// Незаполненный чанк уже зарезервирован в stream_write
+	if (strm->filled != 0)
+	{
+		stream_publish(strm);
+	}
+
+	counter_store(&strm->is_closed, true);
+	stream_notify(strm);
+	return 0;
+}
+
+int stream_fail(stream *const strm)
+{
+	if (strm == NULL)
+	{
+		return -1;
+	}
+
+	// Признак ошибки выставляется до закрытия, чтобы получатель не принял неполный текст за целый
+	counter_store(&strm->is_failed, true);
+	counter_store(&strm->is_closed, true);
+	stream_notify(strm);
+	return 0;
+}
+
+size_t stream_read(stream *const strm, char *const buffer)
+{
+	if (strm == NULL || buffer == NULL)
+	{
+		return 0;
+	}
+
+	const size_t head = counter_load(&strm->head);
+	stream_wait(strm, &has_published_chunk, head);
+
+	// Признак закрытия выставляется после публикации последнего чанка
+	if (head == counter_load(&strm->tail) || counter_load(&strm->is_failed))
+	{
+		return 0;
+	}
+
+	const size_t size = strm->sizes[head % strm->capacity];
+	memcpy(buffer, &strm->chunks[(head % strm->capacity) * strm->chunk_size], size);
+
+	counter_store(&strm->head, head + 1);
+	stream_notify(strm);
+	return size;
+}
+
+int stream_cancel(stream *const strm)
+{
+	if (strm == NULL)
+	{
+		return -1;
+	}
+
+	counter_store(&strm->is_cancelled, true);
+	stream_notify(strm);
+	return 0;
+}
+
+
+size_t stream_get_chunk_size(const stream *const strm)
+{
+	return strm != NULL ? strm->chunk_size : 0;
+}
+
+bool stream_is_failed(stream *const strm)
+{
+	return strm != NULL && counter_load(&strm->is_failed);
+}
+
+
+int stream_free(stream *const strm)
+{
+	if (strm == NULL)
+	{
+		return -1;
+	}
+
+#ifndef _WIN32
+	pthread_cond_destroy(&strm->changed);
+	pthread_mutex_destroy(&strm->mutex);
+#endif
+
+	free(strm->chunks);
+	free(strm->sizes);
+	free(strm);
+	return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "dll.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *	Bounded queue of text chunks between one producer and one consumer thread,
+ *	counters are lock-free, a waiting side blocks after short spinning,
+ *	structure is opaque because its counters are atomic
+ */
+typedef struct stream stream;
+
+
+/**
+ *	Create new stream
+ *
+ *	@param	chunk_size	Size of one chunk
+ *	@param	capacity	Number of chunks in queue
+ *
+ *	@return	Stream, @c NULL on failure
+ */
+EXPORTED stream *stream_create(const size_t chunk_size, const size_t capacity);
+
+
+/**
+ *	Write data to stream, waits while queue is full
+ *
+ *	@param	strm		Stream
+ *	@param	data		Data
+ *	@param	size		Size of data
+ *
+ *	@return	@c 0 on success, @c -1 on failure or if stream was cancelled
+ */
+EXPORTED int stream_write(stream *const strm, const char *const data, const size_t size);
+
+/**
+ *	Publish the last chunk and mark end of stream, called by producer
+ *
+ *	@param	strm		Stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int stream_close(stream *const strm);
+
+/**
+ *	Mark text as incomplete and end stream, called by producer on failure
+ *
+ *	@param	strm		Stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int stream_fail(stream *const strm);
+
+/**
+ *	Read next chunk from stream, waits while queue is empty
+ *
+ *	@param	strm		Stream
+ *	@param	buffer		Buffer of chunk size at least
+ *
+ *	@return	Size of chunk, @c 0 at the end of stream or if stream was failed
+ */
+EXPORTED size_t stream_read(stream *const strm, char *const buffer);
+
+/**
+ *	Discard the rest of stream, called by consumer to release waiting producer
+ *
+ *	@param	strm		Stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int stream_cancel(stream *const strm);
+
+
+/**
+ *	Get size of one chunk
+ *
+ *	@param	strm		Stream
+ *
+ *	@return	Chunk size, @c 0 on failure
+ */
+EXPORTED size_t stream_get_chunk_size(const stream *const strm);
+
+/**
+ *	Check that producer failed and text of stream is incomplete
+ *
+ *	@param	strm		Stream
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+EXPORTED bool stream_is_failed(stream *const strm);
+
+
+/**
+ *	Free allocated memory
+ *
+ *	@param	strm		Stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int stream_free(stream *const strm);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -25,7 +25,8 @@ static inline int strings_add_index(strings *const vec)
 {
 	if (vec->indexes_size == vec->indexes_alloc)
 	{
-		size_t *indexes_new = realloc(vec->indexes, 2 * vec->indexes_alloc * sizeof(size_t));
+		size_t *indexes_new = arena_reallocate(vec->region, vec->indexes
+			, vec->indexes_alloc * sizeof(size_t), 2 * vec->indexes_alloc * sizeof(size_t));
 		if (indexes_new == NULL)
 		{
 			return -1;
@@ -46,7 +47,8 @@ static inline int strings_increase(strings *const vec, const size_t size)
 		return 0;
 	}
 
-	char *all_strings_new = realloc(vec->all_strings, 2 * vec->all_strings_alloc * sizeof(char));
+	char *all_strings_new = arena_reallocate(vec->region, vec->all_strings
+		, vec->all_strings_alloc * sizeof(char), 2 * vec->all_strings_alloc * sizeof(char));
 	if (all_strings_new == NULL)
 	{
 		return -1;
@@ -68,13 +70,19 @@ static inline int strings_increase(strings *const vec, const size_t size)
 
 
 strings strings_create(const size_t alloc)
+{
+	return strings_create_in(NULL, alloc);
+}
+
+strings strings_create_in(arena *const region, const size_t alloc)
 {
 	strings vec;
+	vec.region = region;
 
 	vec.indexes_size = 0;
 	vec.indexes_alloc = alloc != 0 ? alloc : 1;
 
-	vec.indexes = malloc(vec.indexes_alloc * sizeof(size_t));	
+	vec.indexes = arena_allocate(region, vec.indexes_alloc * sizeof(size_t));
 	if (vec.indexes == NULL)
 	{
 		return vec;
@@ -83,10 +91,10 @@ strings strings_create(const size_t alloc)
 	vec.all_strings_size = 0;
 	vec.all_strings_alloc = vec.indexes_alloc * AVERAGE_STRING_SIZE;
 
-	vec.all_strings = malloc(vec.all_strings_alloc * sizeof(char));
+	vec.all_strings = arena_allocate(region, vec.all_strings_alloc * sizeof(char));
 	if (vec.all_strings == NULL)
 	{
-		free(vec.indexes);
+		arena_free(region, vec.indexes);
 		return vec;
 	}
 
@@ -217,10 +225,10 @@ int strings_clear(strings *const vec)
 		return -1;
 	}
 
-	free(vec->indexes);
+	arena_free(vec->region, vec->indexes);
 	vec->indexes = NULL;
 
-	free(vec->all_strings);
+	arena_free(vec->region, vec->all_strings);
 	vec->all_strings = NULL;
 
 	return 0;
@@ -35,6 +35,8 @@ typedef struct strings
 	size_t *indexes;				/**< Indexes array */
 	size_t indexes_size;			/**< Size of indexes array */
 	size_t indexes_alloc;			/**< Allocated size of indexes array */
+
+	arena *region;					/**< Memory region, @c NULL for heap */
 } strings;
 
 
@@ -47,6 +49,16 @@ typedef struct strings
  */
 EXPORTED strings strings_create(const size_t alloc);
 
+/**
+ *	Create new strings vector in memory region
+ *
+ *	@param	region			Memory region, @c NULL for heap
+ *	@param	alloc			Initializer of allocated size
+ *
+ *	@return	Strings vector
+ */
+EXPORTED strings strings_create_in(arena *const region, const size_t alloc);
+
 
 /**
  *	Add new string
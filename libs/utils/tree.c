@@ -17,31 +17,39 @@
 #include "tree.h"
 
 
-static inline bool is_negative(const item_t value)
-{
-	return value >> (8 * sizeof(item_t) - 1);
-}
+extern bool node_tree_is_correct(const node_tree *const tree);
+extern bool node_is_correct(const node *const nd);
+
+extern item_t node_get_type(const node *const nd);
+extern size_t node_get_argc(const node *const nd);
+extern item_t node_get_arg(const node *const nd, const size_t index);
+extern size_t node_get_amount(const node *const nd);
+
+
+/*
+ *	Узел дерева занимает ячейки:
+ *		[parent][number][type][amount][children][argc][args...]
+ *	где индекс узла указывает на amount, children - на таблицу из amount индексов детей.
+ *	Таблица детей выделяется в конце дерева с запасом до степени двойки и переносится при заполнении.
+ *	64-битные аргументы хранятся в отдельной таблице, в ячейке аргумента - индекс значения в ней.
+ *	Туда же попадают обычные аргументы, не поместившиеся в ячейку, их ячейка - CELL_MIN + индекс.
+ */
 
-static inline item_t to_negative(const size_t value)
-{
-	return ~(item_t)value + 1;
-}
 
-static inline size_t from_negative(const item_t value)
+static inline void cell_swap(cell_vector *const vec, size_t fst, size_t snd)
 {
-	return (size_t)(~value + 1);
+	const cell_t temp = cell_vector_at(vec, fst);
+	*cell_vector_at_mut(vec, fst) = cell_vector_at(vec, snd);
+	*cell_vector_at_mut(vec, snd) = temp;
 }
 
 
-static inline void vector_swap(vector *const vec, size_t fst, size_t snd)
+static inline size_t ref_get_parent(const node *const nd)
 {
-	const item_t temp = vector_get(vec, fst);
-	vector_set(vec, fst, vector_get(vec, snd));
-	vector_set(vec, snd, temp);
+	return nd->index - 3;
 }
 
-
-static inline size_t ref_get_next(const node *const nd)
+static inline size_t ref_get_number(const node *const nd)
 {
 	return nd->index - 2;
 }
@@ -61,25 +69,56 @@ static inline size_t ref_get_argc(const node *const nd)
 	return nd->index + 2;
 }
 
+static inline size_t ref_get_child(const node *const nd, const size_t index)
+{
+	return (size_t)cell_vector_at(&nd->tree->cells, ref_get_children(nd)) + index;
+}
+
+
+static inline void ref_set_parent(const node *const nd, const cell_t value)
+{
+	*cell_vector_at_mut(&nd->tree->cells, ref_get_parent(nd)) = value;
+}
+
+static inline void ref_set_number(const node *const nd, const cell_t value)
+{
+	*cell_vector_at_mut(&nd->tree->cells, ref_get_number(nd)) = value;
+}
+
+static inline void ref_set_amount(const node *const nd, const cell_t value)
+{
+	*cell_vector_at_mut(&nd->tree->cells, ref_get_amount(nd)) = value;
+}
 
-static inline int ref_set_next(const node *const nd, const item_t value)
+static inline void ref_set_children(const node *const nd, const cell_t value)
 {
-	return vector_set(nd->tree, ref_get_next(nd), value);
+	*cell_vector_at_mut(&nd->tree->cells, ref_get_children(nd)) = value;
 }
 
-static inline int ref_set_amount(const node *const nd, const item_t value)
+static inline void ref_set_argc(const node *const nd, const cell_t value)
 {
-	return vector_set(nd->tree, ref_get_amount(nd), value);
+	*cell_vector_at_mut(&nd->tree->cells, ref_get_argc(nd)) = value;
 }
 
-static inline int ref_set_children(const node *const nd, const item_t value)
+static inline void ref_set_child(const node *const nd, const size_t index, const node *const child)
 {
-	return vector_set(nd->tree, ref_get_children(nd), value);
+	*cell_vector_at_mut(&nd->tree->cells, ref_get_child(nd, index)) = (cell_t)child->index;
+	ref_set_parent(child, (cell_t)nd->index);
+	ref_set_number(child, (cell_t)index);
 }
 
-static inline int ref_set_argc(const node *const nd, const item_t value)
+
+/**	Convert argument to cell, argument out of cell range is moved to table of 64-bit values */
+static inline cell_t arg_to_cell(node_tree *const tree, const item_t arg)
 {
-	return vector_set(nd->tree, ref_get_argc(nd), value);
+	if (cell_fits_item(arg))
+	{
+		return cell_from_item(arg);
+	}
+
+	const size_t index = vector_add_int64(&tree->payloads, (int64_t)arg);
+	assert(index <= (size_t)(CELL_MAX / 2));
+	return (cell_t)(CELL_MIN + (cell_t)index);
 }
 
 
@@ -97,21 +136,33 @@ static node node_search_parent(const node *const nd, size_t *const number)
 		return node_broken();
 	}
 
-	size_t child_number = 1;
-	item_t index = vector_get(nd->tree, ref_get_next(nd));
-	while (!is_negative(index) && index != 0)
+	node parent = { nd->tree, (size_t)cell_vector_at(&nd->tree->cells, ref_get_parent(nd)) };
+	if (number != NULL)
 	{
-		index = vector_get(nd->tree, (size_t)index - 2);
-		child_number++;
+		*number = (size_t)cell_vector_at(&nd->tree->cells, ref_get_number(nd));
 	}
 
-	node parent = { nd->tree, from_negative(index) };
-	if (number != NULL)
+	return parent;
+}
+
+/**	Reserve place in children table for one more child */
+static void node_reserve_child(const node *const nd)
+{
+	const size_t amount = node_get_amount(nd);
+	if ((amount & (amount - 1)) != 0)
 	{
-		*number = node_get_amount(&parent) - child_number;
+		// Ёмкость таблицы - ближайшая степень двойки, место ещё есть
+		return;
 	}
 
-	return parent;
+	const size_t table = cell_vector_size(&nd->tree->cells);
+	cell_vector_increase(&nd->tree->cells, amount == 0 ? 1 : 2 * amount);
+	for (size_t i = 0; i < amount; i++)
+	{
+		*cell_vector_at_mut(&nd->tree->cells, table + i) = cell_vector_at(&nd->tree->cells, ref_get_child(nd, i));
+	}
+
+	ref_set_children(nd, (cell_t)table);
 }
 
 
@@ -124,14 +175,47 @@ static node node_search_parent(const node *const nd, size_t *const number)
  */
 
 
-node node_get_root(vector *const tree)
+node_tree node_tree_create(const size_t alloc)
+{
+	return node_tree_create_in(NULL, alloc);
+}
+
+node_tree node_tree_create_in(arena *const region, const size_t alloc)
+{
+	node_tree tree;
+
+	tree.cells = cell_vector_create_in(region, alloc);
+	tree.payloads = vector_create_in(region, 0);
+
+	return tree;
+}
+
+int node_tree_clear(node_tree *const tree)
+{
+	if (!node_tree_is_correct(tree))
+	{
+		return -1;
+	}
+
+	cell_vector_clear(&tree->cells);
+	vector_clear(&tree->payloads);
+	return 0;
+}
+
+
+node node_get_root(node_tree *const tree)
 {
-	const size_t size = vector_size(tree);
+	if (!node_tree_is_correct(tree))
+	{
+		return node_broken();
+	}
+
+	const size_t size = cell_vector_size(&tree->cells);
 	if (size == 0)
 	{
-		vector_increase(tree, 3);
+		cell_vector_increase(&tree->cells, 3);
 	}
-	else if (size == SIZE_MAX || size < 3 || vector_get(tree, 2) < 0)
+	else if (size < 3 || cell_vector_get(&tree->cells, 2) < 0)
 	{
 		return node_broken();
 	}
@@ -147,50 +231,43 @@ node node_get_child(const node *const nd, const size_t index)
 		return node_broken();
 	}
 
-	size_t child_index = (size_t)vector_get(nd->tree, ref_get_children(nd));
-	for (size_t i = 0; i < index; i++)
-	{
-		child_index = (size_t)vector_get(nd->tree, child_index - 2);
-	}
-
-	node child = { nd->tree, child_index };
+	node child = { nd->tree, (size_t)cell_vector_at(&nd->tree->cells, ref_get_child(nd, index)) };
 	return child;
 }
 
-node node_get_parent(const node *const nd)
+node node_get_sibling(const node *const nd)
 {
-	return node_search_parent(nd, NULL);
+	size_t number = 0;
+	const node parent = node_search_parent(nd, &number);
+	return node_get_child(&parent, number + 1);
 }
 
-
-item_t node_get_type(const node *const nd)
+int node_set_sibling(node *const nd)
 {
-	return node_is_correct(nd) && nd->index != 0 ? vector_get(nd->tree, nd->index - 1) : ITEM_MAX;
-}
+	const node sibling = node_get_sibling(nd);
+	if (!node_is_correct(&sibling))
+	{
+		return -1;
+	}
 
-size_t node_get_argc(const node *const nd)
-{
-	return node_is_correct(nd) ? (size_t)vector_get(nd->tree, ref_get_argc(nd)) : 0;
+	*nd = sibling;
+	return 0;
 }
 
-item_t node_get_arg(const node *const nd, const size_t index)
+node node_get_parent(const node *const nd)
 {
-	return index < node_get_argc(nd) ? vector_get(nd->tree, ref_get_argc(nd) + 1 + index) : ITEM_MAX;
+	return node_search_parent(nd, NULL);
 }
 
+
 double node_get_arg_double(const node *const nd, const size_t index)
 {
-	return index + DOUBLE_SIZE <= node_get_argc(nd) ? vector_get_double(nd->tree, ref_get_argc(nd) + 1 + index) : DBL_MAX;
+	return index < node_get_argc(nd) ? vector_get_double(&nd->tree->payloads, (size_t)node_get_arg(nd, index)) : DBL_MAX;
 }
 
 int64_t node_get_arg_int64(const node *const nd, const size_t index)
 {
-	return index + INT64_SIZE <= node_get_argc(nd) ? vector_get_int64(nd->tree, ref_get_argc(nd) + 1 + index) : LLONG_MAX;
-}
-
-size_t node_get_amount(const node *const nd)
-{
-	return node_is_correct(nd) ? (size_t)vector_get(nd->tree, ref_get_amount(nd)) : 0;
+	return index < node_get_argc(nd) ? vector_get_int64(&nd->tree->payloads, (size_t)node_get_arg(nd, index)) : LLONG_MAX;
 }
 
 
@@ -201,21 +278,25 @@ node node_get_next(const node *const nd)
 		return node_broken();
 	}
 
-	node next = { nd->tree, (size_t)vector_get(nd->tree, ref_get_children(nd)) };
+	if (node_get_amount(nd) != 0)
+	{
+		return node_get_child(nd, 0);
+	}
 
-	if (node_get_amount(nd) == 0)
+	// Поднимаемся, пока не найдётся следующий брат
+	node current = *nd;
+	while (current.index != 0)
 	{
-		item_t index = vector_get(nd->tree, ref_get_next(nd));
-		while (is_negative(index))
+		const node sibling = node_get_sibling(&current);
+		if (node_is_correct(&sibling))
 		{
-			// Get next reference from parent
-			index = vector_get(nd->tree, from_negative(index) - 2);
+			return sibling;
 		}
 
-		next.index = (size_t)index;
+		current = node_get_parent(&current);
 	}
 
-	return next.index != 0 ? next : node_broken();
+	return node_broken();
 }
 
 int node_set_next(node *const nd)
@@ -238,24 +319,18 @@ node node_add_child(const node *const nd, const item_t type)
 		return node_broken();
 	}
 
-	vector_add(nd->tree, to_negative(nd->index));
-	vector_add(nd->tree, type);
-	node child = { nd->tree, vector_add(nd->tree, 0) };
-	vector_increase(nd->tree, 2);
+	// Таблица детей переносится до добавления ребёнка, чтобы его аргументы оставались в конце дерева
+	node_reserve_child(nd);
 
 	const size_t amount = node_get_amount(nd);
-	ref_set_amount(nd, (item_t)(amount + 1));
-
-	if (amount == 0)
-	{
-		ref_set_children(nd, (item_t)child.index);
-	}
-	else
-	{
-		node prev = node_get_child(nd, amount - 1);
-		ref_set_next(&prev, (item_t)child.index);
-	}
-
+	cell_vector_push_unchecked(&nd->tree->cells, (cell_t)nd->index);
+	cell_vector_push_unchecked(&nd->tree->cells, (cell_t)amount);
+	cell_vector_push_unchecked(&nd->tree->cells, cell_from_item(type));
+	node child = { nd->tree, cell_vector_push_unchecked(&nd->tree->cells, 0) };
+	cell_vector_increase(&nd->tree->cells, 2);
+
+	*cell_vector_at_mut(&nd->tree->cells, ref_get_child(nd, amount)) = (cell_t)child.index;
+	ref_set_amount(nd, (cell_t)(amount + 1));
 	return child;
 }
 
@@ -271,7 +346,8 @@ int node_set_type(const node *const nd, const item_t type)
 		return -2;
 	}
 
-	return vector_set(nd->tree, nd->index - 1, type);
+	*cell_vector_at_mut(&nd->tree->cells, nd->index - 1) = cell_from_item(type);
+	return 0;
 }
 
 int node_add_arg(const node *const nd, const item_t arg)
@@ -286,8 +362,8 @@ int node_add_arg(const node *const nd, const item_t arg)
 		return -2;
 	}
 	
-	vector_add(nd->tree, arg);
-	ref_set_argc(nd, (item_t)node_get_argc(nd) + 1);
+	cell_vector_push_unchecked(&nd->tree->cells, arg_to_cell(nd->tree, arg));
+	ref_set_argc(nd, (cell_t)node_get_argc(nd) + 1);
 
 	return 0;
 }
@@ -304,8 +380,8 @@ int node_add_arg_double(const node *const nd, const double arg)
 		return -2;
 	}
 	
-	vector_add_double(nd->tree, arg);
-	ref_set_argc(nd, (item_t)(node_get_argc(nd) + DOUBLE_SIZE));
+	cell_vector_push_unchecked(&nd->tree->cells, (cell_t)vector_add_double(&nd->tree->payloads, arg));
+	ref_set_argc(nd, (cell_t)node_get_argc(nd) + 1);
 
 	return 0;
 }
@@ -322,8 +398,8 @@ int node_add_arg_int64(const node *const nd, const int64_t arg)
 		return -2;
 	}
 	
-	vector_add_int64(nd->tree, arg);
-	ref_set_argc(nd, (item_t)(node_get_argc(nd) + INT64_SIZE));
+	cell_vector_push_unchecked(&nd->tree->cells, (cell_t)vector_add_int64(&nd->tree->payloads, arg));
+	ref_set_argc(nd, (cell_t)node_get_argc(nd) + 1);
 
 	return 0;
 }
@@ -335,27 +411,31 @@ int node_set_arg(const node *const nd, const size_t index, const item_t arg)
 		return -1;
 	}
 
-	return vector_set(nd->tree, ref_get_argc(nd) + 1 + index, arg);
+	*cell_vector_at_mut(&nd->tree->cells, ref_get_argc(nd) + 1 + index) = arg_to_cell(nd->tree, arg);
+	return 0;
 }
 
 size_t node_set_arg_double(const node *const nd, const size_t index, const double arg)
 {
-	if (index + DOUBLE_SIZE > node_get_argc(nd))
+	if (index >= node_get_argc(nd))
 	{
 		return SIZE_MAX;
 	}
 
-	return vector_set_double(nd->tree, ref_get_argc(nd) + 1 + index, arg);
+	// Значение всегда добавляется в конец таблицы, в ячейке могло быть обычное значение
+	*cell_vector_at_mut(&nd->tree->cells, ref_get_argc(nd) + 1 + index) = (cell_t)vector_add_double(&nd->tree->payloads, arg);
+	return 1;
 }
 
 size_t node_set_arg_int64(const node *const nd, const size_t index, const int64_t arg)
 {
-	if (index + INT64_SIZE > node_get_argc(nd))
+	if (index >= node_get_argc(nd))
 	{
 		return SIZE_MAX;
 	}
 
-	return vector_set_int64(nd->tree, ref_get_argc(nd) + 1 + index, arg);
+	*cell_vector_at_mut(&nd->tree->cells, ref_get_argc(nd) + 1 + index) = (cell_t)vector_add_int64(&nd->tree->payloads, arg);
+	return 1;
 }
 
 
@@ -377,9 +457,10 @@ size_t node_save(const node *const nd)
 		: SIZE_MAX;
 }
 
-node node_load(vector *const tree, const size_t index)
+node node_load(node_tree *const tree, const size_t index)
 {
-	if (!vector_is_correct(tree) || vector_get(tree, index + 2) >= (item_t)(vector_size(tree) - index - 2))
+	if (!node_tree_is_correct(tree) || index + 2 >= cell_vector_size(&tree->cells)
+		|| (size_t)cell_vector_at(&tree->cells, index + 2) >= cell_vector_size(&tree->cells) - index - 2)
 	{
 		return node_broken();
 	}
@@ -397,26 +478,18 @@ node node_insert(const node *const nd, const item_t type, const size_t argc)
 		return node_broken();
 	}
 
-	size_t reference;
-	if (index == 0)
-	{
-		reference = ref_get_children(&parent);
-	}
-	else
-	{
-		const node prev = node_get_child(&parent, index - 1);
-		reference = ref_get_next(&prev);
-	}
-
-	vector_add(nd->tree, vector_get(nd->tree, ref_get_next(nd)));
-	vector_add(nd->tree, type);
-	node child = { nd->tree, vector_add(nd->tree, 1) };
-	vector_add(nd->tree, (item_t)nd->index);
-	vector_add(nd->tree, (item_t)argc);
-	vector_increase(nd->tree, argc);
+	const size_t table = cell_vector_push_unchecked(&nd->tree->cells, (cell_t)nd->index);
+	cell_vector_push_unchecked(&nd->tree->cells, (cell_t)parent.index);
+	cell_vector_push_unchecked(&nd->tree->cells, (cell_t)index);
+	cell_vector_push_unchecked(&nd->tree->cells, cell_from_item(type));
+	node child = { nd->tree, cell_vector_push_unchecked(&nd->tree->cells, 1) };
+	cell_vector_push_unchecked(&nd->tree->cells, (cell_t)table);
+	cell_vector_push_unchecked(&nd->tree->cells, (cell_t)argc);
+	cell_vector_increase(&nd->tree->cells, argc);
 
-	vector_set(nd->tree, reference, (item_t)child.index);
-	ref_set_next(nd, to_negative(child.index));
+	*cell_vector_at_mut(&nd->tree->cells, ref_get_child(&parent, index)) = (cell_t)child.index;
+	ref_set_parent(nd, (cell_t)child.index);
+	ref_set_number(nd, 0);
 	return child;
 }
 
@@ -427,21 +500,21 @@ int node_order(const node *const fst, const node *const snd)
 		return -1;
 	}
 
-	vector_swap(fst->tree, ref_get_amount(fst), ref_get_amount(snd));
-	vector_swap(fst->tree, ref_get_children(fst), ref_get_children(snd));
+	cell_swap(&fst->tree->cells, ref_get_amount(fst), ref_get_amount(snd));
+	cell_swap(&fst->tree->cells, ref_get_children(fst), ref_get_children(snd));
 
 	const size_t fst_amount = node_get_amount(fst);
-	if (fst_amount != 0)
+	for (size_t i = 0; i < fst_amount; i++)
 	{
-		const node child = node_get_child(fst, fst_amount - 1);
-		ref_set_next(&child, to_negative(fst->index));
+		const node child = node_get_child(fst, i);
+		ref_set_parent(&child, (cell_t)fst->index);
 	}
 
 	const size_t snd_amount = node_get_amount(snd);
-	if (snd_amount != 0)
+	for (size_t i = 0; i < snd_amount; i++)
 	{
-		const node child = node_get_child(snd, snd_amount - 1);
-		ref_set_next(&child, to_negative(snd->index));
+		const node child = node_get_child(snd, i);
+		ref_set_parent(&child, (cell_t)snd->index);
 	}
 
 	return 0;
@@ -460,29 +533,8 @@ int node_swap(const node *const fst, const node *const snd)
 		return -1;
 	}
 
-	vector *const tree = fst->tree;
-	if (fst_index == 0 && snd_index == 0)
-	{
-		vector_swap(tree, ref_get_children(&fst_parent), ref_get_children(&snd_parent));
-	}
-	else if (fst_index == 0)	// && snd_index != 0
-	{
-		const node snd_prev = node_get_child(&snd_parent, snd_index - 1);
-		vector_swap(tree, ref_get_children(&fst_parent), ref_get_next(&snd_prev));
-	}
-	else if (snd_index == 0)	// && fst_index != 0
-	{
-		const node fst_prev = node_get_child(&fst_parent, fst_index - 1);
-		vector_swap(tree, ref_get_next(&fst_prev), ref_get_children(&snd_parent));
-	}
-	else						// fst_index != 0 && snd_index != 0
-	{
-		const node fst_prev = node_get_child(&fst_parent, fst_index - 1);
-		const node snd_prev = node_get_child(&snd_parent, snd_index - 1);
-		vector_swap(tree, ref_get_next(&fst_prev), ref_get_next(&snd_prev));
-	}
-
-	vector_swap(tree, ref_get_next(fst), ref_get_next(snd));
+	ref_set_child(&fst_parent, fst_index, snd);
+	ref_set_child(&snd_parent, snd_index, fst);
 	return 0;
 }
 
@@ -495,35 +547,19 @@ int node_remove(node *const nd)
 		return -1;
 	}
 
-	if (index == 0)
-	{
-		ref_set_amount(&parent, (item_t)node_get_amount(&parent) - 1);
-
-		if (node_get_amount(&parent) != 0)
-		{
-			ref_set_children(&parent, vector_get(nd->tree, ref_get_next(nd)));
-		}
-	}
-	else
+	const size_t amount = node_get_amount(&parent);
+	for (size_t i = index + 1; i < amount; i++)
 	{
-		*nd = node_get_child(&parent, index - 1);
-		const size_t reference = (size_t)vector_get(nd->tree, ref_get_next(nd));
-		ref_set_next(nd, vector_get(nd->tree, reference - 2));
-
-		nd->index = reference;
-		ref_set_amount(&parent, (item_t)node_get_amount(&parent) - 1);
+		const node child = node_get_child(&parent, i);
+		ref_set_child(&parent, i - 1, &child);
 	}
+	ref_set_amount(&parent, (cell_t)amount - 1);
 
-	if (node_get_amount(nd) == 0 && (ref_get_argc(nd) + node_get_argc(nd)) == vector_size(nd->tree) - 1)
+	if (node_get_amount(nd) == 0 && (ref_get_argc(nd) + node_get_argc(nd)) == cell_vector_size(&nd->tree->cells) - 1)
 	{
-		vector_resize(nd->tree, ref_get_next(nd));
+		cell_vector_resize(&nd->tree->cells, ref_get_parent(nd));
 	}
 
 	*nd = node_broken();
 	return 0;
 }
-
-bool node_is_correct(const node *const nd)
-{
-	return nd != NULL && vector_is_correct(nd->tree) && nd->index != SIZE_MAX;
-}
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "cell_vector.h"
 #include "vector.h"
 
 
@@ -23,14 +24,75 @@
 extern "C" {
 #endif
 
+/** Tree table */
+typedef struct node_tree
+{
+	cell_vector cells;		/**< Node cells */
+	vector payloads;		/**< 64-bit arguments, referenced from node cells */
+} node_tree;
+
 /** Tree node */
 typedef struct node
 {
-	vector *tree;			/**< Tree reference */
+	node_tree *tree;		/**< Tree reference */
 	size_t index;			/**< Node index */
 } node;
 
 
+/**
+ *	Create new tree table
+ *
+ *	@param	alloc		Initializer of allocated size
+ *
+ *	@return	Tree table
+ */
+EXPORTED node_tree node_tree_create(const size_t alloc);
+
+/**
+ *	Create new tree table in memory region
+ *
+ *	@param	region		Memory region, @c NULL for heap
+ *	@param	alloc		Initializer of allocated size
+ *
+ *	@return	Tree table
+ */
+EXPORTED node_tree node_tree_create_in(arena *const region, const size_t alloc);
+
+/**
+ *	Check that tree table is correct
+ *
+ *	@param	tree		Tree table
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+inline bool node_tree_is_correct(const node_tree *const tree)
+{
+	return tree != NULL && cell_vector_is_correct(&tree->cells) && vector_is_correct(&tree->payloads);
+}
+
+/**
+ *	Free allocated memory
+ *
+ *	@param	tree		Tree table
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int node_tree_clear(node_tree *const tree);
+
+
+/**
+ *	Check that node is correct
+ *
+ *	@param	nd			Node structure
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+inline bool node_is_correct(const node *const nd)
+{
+	return nd != NULL && nd->tree != NULL && cell_vector_is_correct(&nd->tree->cells) && nd->index != SIZE_MAX;
+}
+
+
 /**
  *	Get tree root node
  *
@@ -38,7 +100,7 @@ typedef struct node
  *
  *	@return	Root node
  */
-EXPORTED node node_get_root(vector *const tree);
+EXPORTED node node_get_root(node_tree *const tree);
 
 /**
  *	Get child from node by index
@@ -50,6 +112,24 @@ EXPORTED node node_get_root(vector *const tree);
  */
 EXPORTED node node_get_child(const node *const nd, const size_t index);
 
+/**
+ *	Get next sibling of node
+ *
+ *	@param	nd			Current node
+ *
+ *	@return	Next sibling, broken node for the last child
+ */
+EXPORTED node node_get_sibling(const node *const nd);
+
+/**
+ *	Set node to its next sibling
+ *
+ *	@param	nd			Current node
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int node_set_sibling(node *const nd);
+
 /**
  *	Get parent of node
  *
@@ -67,7 +147,10 @@ EXPORTED node node_get_parent(const node *const nd);
  *
  *	@return	Node type, @c ITEM_MAX on failure
  */
-EXPORTED item_t node_get_type(const node *const nd);
+inline item_t node_get_type(const node *const nd)
+{
+	return node_is_correct(nd) && nd->index != 0 ? cell_to_item(cell_vector_at(&nd->tree->cells, nd->index - 1)) : ITEM_MAX;
+}
 
 /**
  *	Get amount of arguments
@@ -76,7 +159,10 @@ EXPORTED item_t node_get_type(const node *const nd);
  *
  *	@return	Amount of arguments
  */
-EXPORTED size_t node_get_argc(const node *const nd);
+inline size_t node_get_argc(const node *const nd)
+{
+	return node_is_correct(nd) ? (size_t)cell_vector_at(&nd->tree->cells, nd->index + 2) : 0;
+}
 
 /**
  *	Get argument from node by index
@@ -86,7 +172,17 @@ EXPORTED size_t node_get_argc(const node *const nd);
  *
  *	@return	Argument, @c ITEM_MAX on failure
  */
-EXPORTED item_t node_get_arg(const node *const nd, const size_t index);
+inline item_t node_get_arg(const node *const nd, const size_t index)
+{
+	if (index >= node_get_argc(nd))
+	{
+		return ITEM_MAX;
+	}
+
+	// Аргументы вне диапазона ячейки хранятся в таблице 64-битных значений
+	const cell_t arg = cell_vector_at(&nd->tree->cells, nd->index + 3 + index);
+	return arg < CELL_MIN / 2 ? (item_t)vector_get_int64(&nd->tree->payloads, (size_t)(arg - CELL_MIN)) : cell_to_item(arg);
+}
 
 /**
  *	Get double argument from node by index
@@ -115,7 +211,10 @@ EXPORTED int64_t node_get_arg_int64(const node *const nd, const size_t index);
  *
  *	@return	Amount of children
  */
-EXPORTED size_t node_get_amount(const node *const nd);
+inline size_t node_get_amount(const node *const nd)
+{
+	return node_is_correct(nd) ? (size_t)cell_vector_at(&nd->tree->cells, nd->index) : 0;
+}
 
 
 /**
@@ -172,7 +271,7 @@ EXPORTED int node_set_type(const node *const nd, const item_t type);
 EXPORTED int node_add_arg(const node *const nd, const item_t arg);
 
 /**
- *	Add new node double argument
+ *	Add new node double argument, it takes one argument cell
  *
  *	@param	nd			Node structure
  *	@param	arg			Node double argument
@@ -184,7 +283,7 @@ EXPORTED int node_add_arg(const node *const nd, const item_t arg);
 EXPORTED int node_add_arg_double(const node *const nd, const double arg);
 
 /**
- *	Add new node 64-bit argument
+ *	Add new node 64-bit argument, it takes one argument cell
  *
  *	@param	nd			Node structure
  *	@param	arg			Node 64-bit argument
@@ -256,7 +355,7 @@ EXPORTED size_t node_save(const node *const nd);
  *
  *	@return	Rebuilt node
  */
-EXPORTED node node_load(vector *const tree, const size_t index);
+EXPORTED node node_load(node_tree *const tree, const size_t index);
 
 /**
  *	Insert new node before existing
@@ -298,15 +397,6 @@ EXPORTED int node_swap(const node *const fst, const node *const snd);
  */
 EXPORTED int node_remove(node *const nd);
 
-/**
- *	Check that node is correct
- *
- *	@param	nd			Node structure
- *
- *	@return	@c 1 on true, @c 0 on false
- */
-EXPORTED bool node_is_correct(const node *const nd);
-
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
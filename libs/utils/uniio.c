@@ -18,6 +18,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include "simd.h"
 #include "workspace.h"
 
 #ifdef _WIN32
@@ -26,13 +27,22 @@
 	extern intptr_t _get_osfhandle(int fd);
 #elif __APPLE__
 	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
 #else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
 	#include <unistd.h>
 
 	#define MAX_LINK_SIZE 20
 #endif
 
 #define MAX_FORMAT_SIZE 128
+#define OUT_BLOCK_SIZE 65536
+#define OUT_STREAM_SIZE 1024
+
+#define LINE_MARK "#line "
 
 
 static inline bool is_specifier(const char ch)
@@ -142,8 +152,99 @@ static int in_func_file(universal_io *const io, const char *const format, va_lis
 	return in_func_position(io, format, args, &scan_file_arg);
 }
 
+/** Check that text begins with @c #line mark with path */
+static bool is_path_mark(const char *const text)
+{
+	if (strncmp(text, LINE_MARK, sizeof(LINE_MARK) - 1) != 0)
+	{
+		return false;
+	}
+
+	size_t i = sizeof(LINE_MARK) - 1;
+	while (text[i] >= '0' && text[i] <= '9')
+	{
+		i++;
+	}
+
+	return i != sizeof(LINE_MARK) - 1 && text[i] == ' ' && text[i + 1] == '"';
+}
+
+/**
+ *	Discard received text before the last @c #line mark with path,
+ *	which is before current line and at least one chunk before current position
+ */
+static void in_forget(universal_io *const io, const size_t chunk_size)
+{
+	if (io->in_position < 2 * chunk_size)
+	{
+		return;
+	}
+
+	// Поиск места в тексте не опускается ниже отметки, поэтому текст до неё не нужен
+	size_t position = io->in_position - chunk_size;
+	while (position != 0 && io->in_received[position - 1] != '\n')
+	{
+		position--;
+	}
+
+	while (position != 0 && !(io->in_received[position - 1] == '\n' && is_path_mark(&io->in_received[position])))
+	{
+		position--;
+	}
+
+	// Перевод строки перед отметкой остаётся, это граница поиска начала её строки
+	if (position < chunk_size)
+	{
+		return;
+	}
+
+	position--;
+	memmove(io->in_received, &io->in_received[position], io->in_size - position + 1);
+	io->in_size -= position;
+	io->in_position -= position;
+	io->in_offset += position;
+}
+
+/** Append next chunk of input stream to received text, @c -1 at the end of stream */
+static int in_receive(universal_io *const io)
+{
+	if (io->in_stream == NULL)
+	{
+		return -1;
+	}
+
+	const size_t chunk_size = stream_get_chunk_size(io->in_stream);
+	in_forget(io, chunk_size);
+	if (io->in_size + chunk_size + 1 > io->in_received_size)
+	{
+		const size_t new_size = 2 * io->in_received_size > io->in_size + chunk_size + 1
+			? 2 * io->in_received_size
+			: io->in_size + chunk_size + 1;
+		char *const new_received = realloc(io->in_received, new_size * sizeof(char));
+		if (new_received == NULL)
+		{
+			return -1;
+		}
+
+		io->in_received = new_received;
+		io->in_received_size = new_size;
+		io->in_buffer = new_received;
+	}
+
+	const size_t size = stream_read(io->in_stream, &io->in_received[io->in_size]);
+	io->in_size += size;
+	io->in_received[io->in_size] = '\0';
+
+	return size != 0 ? 0 : -1;
+}
+
 static int in_func_buffer(universal_io *const io, const char *const format, va_list args)
 {
+	// Форматный ввод не умеет дочитывать поток, поэтому текущая строка получается целиком
+	while (in_is_stream(io)
+		&& memchr(&io->in_buffer[io->in_position], '\n', io->in_size - io->in_position) == NULL
+		&& in_receive(io) == 0);
+
 	return in_func_position(io, format, args, &scan_buffer_arg);
 }
 
@@ -189,6 +290,71 @@ static int out_func_user(universal_io *const io, const char *const format, va_li
 	return io->out_user_func(format, args);
 }
 
+static int out_func_stream(universal_io *const io, const char *const format, va_list args)
+{
+	char buffer[OUT_STREAM_SIZE];
+
+	va_list local;
+	va_copy(local, args);
+	const int ret = vsnprintf(buffer, OUT_STREAM_SIZE, format, local);
+	va_end(local);
+
+	if (ret < 0 || (size_t)ret < OUT_STREAM_SIZE)
+	{
+		return ret < 0 || stream_write(io->out_stream, buffer, (size_t)ret) ? -1 : ret;
+	}
+
+	char *const data = malloc(((size_t)ret + 1) * sizeof(char));
+	if (data == NULL)
+	{
+		return -1;
+	}
+
+	vsnprintf(data, (size_t)ret + 1, format, args);
+	const int written = stream_write(io->out_stream, data, (size_t)ret) ? -1 : ret;
+
+	free(data);
+	return written;
+}
+
+static int out_print_func(universal_io *const io, const char *const format, ...)
+{
+	va_list args;
+	va_start(args, format);
+
+	const int ret = io->out_func(io, format, args);
+
+	va_end(args);
+	return ret;
+}
+
+static int out_write_buffer(universal_io *const io, const char *const data, const size_t size)
+{
+	size_t new_size = io->out_size;
+	while (io->out_position + size >= new_size)
+	{
+		new_size *= 2;
+	}
+
+	if (new_size != io->out_size)
+	{
+		char *new_buffer = realloc(io->out_buffer, new_size * sizeof(char));
+		if (new_buffer == NULL)
+		{
+			return -1;
+		}
+
+		io->out_size = new_size;
+		io->out_buffer = new_buffer;
+	}
+
+	memcpy(&io->out_buffer[io->out_position], data, size);
+	io->out_position += size;
+	io->out_buffer[io->out_position] = '\0';
+
+	return (int)size;
+}
+
 
 static inline size_t io_get_path(FILE *const file, char *const buffer)
 {
@@ -223,6 +389,156 @@ static inline size_t io_get_path(FILE *const file, char *const buffer)
 }
 
 
+static inline size_t in_decode_buffer(const universal_io *const io, char32_t *const character)
+{
+	const unsigned char *const symbol = (const unsigned char *)&io->in_buffer[io->in_position];
+	if (io->in_position >= io->in_size)
+	{
+		*character = (char32_t)EOF;
+		return 0;
+	}
+
+	if (symbol[0] < 0x80)
+	{
+		*character = symbol[0];
+		return 1;
+	}
+
+	const size_t size = utf8_symbol_size((char)symbol[0]);
+	if (io->in_position + size > io->in_size)
+	{
+		*character = (char32_t)EOF;
+		return io->in_size - io->in_position;
+	}
+
+	char32_t result = symbol[0] & (0xFF >> (size + 1));
+	for (size_t i = 1; i < size; i++)
+	{
+		result = (result << 6) | (symbol[i] & 0x3F /* 0b00111111 */);
+	}
+
+	*character = size == 1 ? symbol[0] : result;
+	return size;
+}
+
+static char32_t in_next_char_file(universal_io *const io)
+{
+	int symbol = getc(io->in_file);
+	if (symbol == EOF)
+	{
+		return (char32_t)EOF;
+	}
+
+	io->in_position++;
+	char buffer[8] = { (char)symbol };
+
+	const size_t size = utf8_symbol_size(buffer[0]);
+	for (size_t i = 1; i < size; i++)
+	{
+		symbol = getc(io->in_file);
+		if (symbol == EOF)
+		{
+			return (char32_t)EOF;
+		}
+
+		io->in_position++;
+		buffer[i] = (char)symbol;
+	}
+
+	return utf8_convert(buffer);
+}
+
+static int in_scan_func(universal_io *const io, const char *const format, ...)
+{
+	va_list args;
+	va_start(args, format);
+
+	const int ret = in_func_user(io, format, args);
+
+	va_end(args);
+	return ret;
+}
+
+static char32_t in_next_char_func(universal_io *const io)
+{
+	char buffer[8];
+	if (!in_scan_func(io, "%c", &buffer[0]))
+	{
+		return (char32_t)EOF;
+	}
+
+	const size_t size = utf8_symbol_size(buffer[0]);
+	for (size_t i = 1; i < size; i++)
+	{
+		if (!in_scan_func(io, "%c", &buffer[i]))
+		{
+			return (char32_t)EOF;
+		}
+	}
+
+	return utf8_convert(buffer);
+}
+
+
+static inline size_t io_get_size(FILE *const file)
+{
+	if (fseek(file, 0, SEEK_END) != 0)
+	{
+		return SIZE_MAX;
+	}
+
+	const long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	return size >= 0 ? (size_t)size : SIZE_MAX;
+}
+
+static char *io_map_file(FILE *const file, const size_t size, size_t *const mapping_size)
+{
+#ifndef _WIN32
+	// Mapping is only used when the page tail guarantees null-terminated buffer
+	const long page = sysconf(_SC_PAGESIZE);
+	if (page > 0 && size % (size_t)page != 0)
+	{
+		void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+		if (mapping != MAP_FAILED)
+		{
+			*mapping_size = size;
+			return mapping;
+		}
+	}
+#endif
+
+	char *buffer = malloc((size + 1) * sizeof(char));
+	if (buffer == NULL)
+	{
+		return NULL;
+	}
+
+	if (fread(buffer, sizeof(char), size, file) != size)
+	{
+		free(buffer);
+		return NULL;
+	}
+
+	buffer[size] = '\0';
+	*mapping_size = 0;
+	return buffer;
+}
+
+static inline void io_unmap_file(char *const mapping, const size_t mapping_size)
+{
+#ifndef _WIN32
+	if (mapping_size != 0)
+	{
+		munmap(mapping, mapping_size);
+		return;
+	}
+#endif
+
+	free(mapping);
+}
+
+
 /*
  *	 __     __   __     ______   ______     ______     ______   ______     ______     ______
  *	/\ \   /\ "-.\ \   /\__  _\ /\  ___\   /\  == \   /\  ___\ /\  __ \   /\  ___\   /\  ___\
@@ -238,19 +554,29 @@ universal_io io_create(void)
 
 	io.in_file = NULL;
 	io.in_buffer = NULL;
+	io.in_mapping = NULL;
+	io.in_mapping_size = 0;
 
 	io.in_size = 0;
 	io.in_position = 0;
 
+	io.in_stream = NULL;
+	io.in_received = NULL;
+	io.in_received_size = 0;
+	io.in_offset = 0;
+
 	io.in_user_func = NULL;
 	io.in_func = NULL;
 
 	io.out_file = NULL;
+	io.out_block = NULL;
 	io.out_buffer = NULL;
 
 	io.out_size = 0;
 	io.out_position = 0;
 
+	io.out_stream = NULL;
+
 	io.out_user_func = NULL;
 	io.out_func = NULL;
 
@@ -278,6 +604,58 @@ int in_set_file(universal_io *const io, const char *const path)
 	return 0;
 }
 
+int in_set_mmap(universal_io *const io, const char *const path)
+{
+	if (path == NULL || in_clear(io))
+	{
+		return -1;
+	}
+
+	io->in_file = fopen(path, "rb");
+	if (io->in_file == NULL)
+	{
+		return -1;
+	}
+
+	io->in_position = 0;
+	if (in_map_file(io))
+	{
+		in_close_file(io);
+		return -1;
+	}
+
+	return 0;
+}
+
+int in_map_file(universal_io *const io)
+{
+	if (!in_is_file(io))
+	{
+		return -1;
+	}
+
+	if (in_is_mmap(io))
+	{
+		return 0;
+	}
+
+	const size_t size = io_get_size(io->in_file);
+	char *const mapping = size != SIZE_MAX ? io_map_file(io->in_file, size, &io->in_mapping_size) : NULL;
+	if (mapping == NULL)
+	{
+		fseek(io->in_file, (long)io->in_position, SEEK_SET);
+		return -1;
+	}
+
+	io->in_mapping = mapping;
+	io->in_buffer = mapping;
+	io->in_size = size;
+
+	io->in_func = &in_func_buffer;
+
+	return 0;
+}
+
 int in_set_buffer(universal_io *const io, const char *const buffer)
 {
 	if (buffer == NULL || in_clear(io))
@@ -308,13 +686,42 @@ int in_set_func(universal_io *const io, const io_user_func func)
 	return 0;
 }
 
+int in_set_stream(universal_io *const io, stream *const strm)
+{
+	if (strm == NULL || in_clear(io))
+	{
+		return -1;
+	}
+
+	io->in_received_size = stream_get_chunk_size(strm) + 1;
+	io->in_received = malloc(io->in_received_size * sizeof(char));
+	if (io->in_received == NULL)
+	{
+		io->in_received_size = 0;
+		return -1;
+	}
+
+	io->in_received[0] = '\0';
+	io->in_stream = strm;
+	io->in_offset = 0;
+
+	io->in_buffer = io->in_received;
+	io->in_size = 0;
+	io->in_position = 0;
+
+	io->in_func = &in_func_buffer;
+
+	return 0;
+}
+
 int in_set_position(universal_io *const io, const size_t position)
 {
 	if (in_is_buffer(io))
 	{
-		if (position <= io->in_size)
+		// Начало полученного из потока текста могло быть отброшено
+		if (position >= io->in_offset && position - io->in_offset <= io->in_size)
 		{
-			io->in_position = position;
+			io->in_position = position - io->in_offset;
 			return 0;
 		}
 
@@ -352,6 +759,14 @@ int in_swap(universal_io *const fst, universal_io *const snd)
 	fst->in_buffer = snd->in_buffer;
 	snd->in_buffer = buffer;
 
+	char *mapping = fst->in_mapping;
+	fst->in_mapping = snd->in_mapping;
+	snd->in_mapping = mapping;
+
+	const size_t mapping_size = fst->in_mapping_size;
+	fst->in_mapping_size = snd->in_mapping_size;
+	snd->in_mapping_size = mapping_size;
+
 	const size_t size = fst->in_size;
 	fst->in_size = snd->in_size;
 	snd->in_size = size;
@@ -360,6 +775,22 @@ int in_swap(universal_io *const fst, universal_io *const snd)
 	fst->in_position = snd->in_position;
 	snd->in_position = position;
 
+	stream *strm = fst->in_stream;
+	fst->in_stream = snd->in_stream;
+	snd->in_stream = strm;
+
+	char *received = fst->in_received;
+	fst->in_received = snd->in_received;
+	snd->in_received = received;
+
+	const size_t received_size = fst->in_received_size;
+	fst->in_received_size = snd->in_received_size;
+	snd->in_received_size = received_size;
+
+	const size_t offset = fst->in_offset;
+	fst->in_offset = snd->in_offset;
+	snd->in_offset = offset;
+
 	const io_user_func user_func = fst->in_user_func;
 	fst->in_user_func = snd->in_user_func;
 	snd->in_user_func = user_func;
@@ -371,6 +802,18 @@ int in_swap(universal_io *const fst, universal_io *const snd)
 	return 0;
 }
 
+int in_receive_rest(universal_io *const io)
+{
+	if (!in_is_stream(io))
+	{
+		return -1;
+	}
+
+	// Позиция не меняется, поэтому текущая строка остаётся в принятом тексте
+	while (in_receive(io) == 0);
+	return stream_is_failed(io->in_stream) ? -1 : 0;
+}
+
 
 bool in_is_correct(const universal_io *const io)
 {
@@ -387,11 +830,21 @@ bool in_is_buffer(const universal_io *const io)
 	return io != NULL && io->in_buffer != NULL;
 }
 
+bool in_is_mmap(const universal_io *const io)
+{
+	return io != NULL && io->in_mapping != NULL;
+}
+
 bool in_is_func(const universal_io *const io)
 {
 	return io != NULL && io->in_user_func != NULL;
 }
 
+bool in_is_stream(const universal_io *const io)
+{
+	return io != NULL && io->in_stream != NULL;
+}
+
 
 io_func in_get_func(const universal_io *const io)
 {
@@ -410,7 +863,105 @@ const char *in_get_buffer(const universal_io *const io)
 
 size_t in_get_position(const universal_io *const io)
 {
-	return in_is_buffer(io) || in_is_file(io) ? io->in_position : 0;
+	return in_is_buffer(io) || in_is_file(io) ? io->in_offset + io->in_position : 0;
+}
+
+
+char32_t in_next_char(universal_io *const io)
+{
+	if (in_is_buffer(io))
+	{
+		char32_t character;
+		size_t size = in_decode_buffer(io, &character);
+		while (character == (char32_t)EOF && in_receive(io) == 0)
+		{
+			size = in_decode_buffer(io, &character);
+		}
+
+		io->in_position += size;
+		return character;
+	}
+
+	if (in_is_file(io))
+	{
+		return in_next_char_file(io);
+	}
+
+	return in_is_func(io) ? in_next_char_func(io) : (char32_t)EOF;
+}
+
+char32_t in_peek_char(universal_io *const io)
+{
+	if (in_is_buffer(io))
+	{
+		char32_t character;
+		in_decode_buffer(io, &character);
+		while (character == (char32_t)EOF && in_receive(io) == 0)
+		{
+			in_decode_buffer(io, &character);
+		}
+
+		return character;
+	}
+
+	if (in_is_file(io))
+	{
+		const size_t position = io->in_position;
+		const char32_t character = in_next_char_file(io);
+		in_set_position(io, position);
+		return character;
+	}
+
+	return (char32_t)EOF;
+}
+
+int in_skip_blank(universal_io *const io)
+{
+	if (!in_is_buffer(io) || simd_get_level() == SIMD_NONE)
+	{
+		return -1;
+	}
+
+	do
+	{
+		io->in_position += simd_skip_blank(&io->in_buffer[io->in_position], io->in_size - io->in_position);
+	} while (io->in_position == io->in_size && in_receive(io) == 0);
+
+	return 0;
+}
+
+int in_skip_until(universal_io *const io, const char *const str)
+{
+	if (!in_is_buffer(io) || str == NULL || str[0] == '\0'
+		|| (str[1] != '\0' && str[2] != '\0') || simd_get_level() == SIMD_NONE)
+	{
+		return -1;
+	}
+
+	const size_t start = io->in_offset + io->in_position;
+	for (;;)
+	{
+		const char *const begin = &io->in_buffer[io->in_position];
+		const size_t size = io->in_size - io->in_position;
+		io->in_position += str[1] == '\0'
+			? simd_find_byte(begin, size, str[0])
+			: simd_find_pair(begin, size, str[0], str[1]);
+
+		if (io->in_position != io->in_size)
+		{
+			return 0;
+		}
+
+		// Пара может быть разрезана границей полученного текста
+		const bool is_cut = str[1] != '\0' && io->in_offset + io->in_position > start
+			&& io->in_buffer[io->in_position - 1] == str[0];
+		if (in_receive(io))
+		{
+			return 0;
+		}
+
+		io->in_position -= is_cut ? 1 : 0;
+	}
 }
 
 
@@ -424,6 +975,16 @@ int in_close_file(universal_io *const io)
 	int ret = fclose(io->in_file);
 	io->in_file = NULL;
 
+	if (in_is_mmap(io))
+	{
+		io_unmap_file(io->in_mapping, io->in_mapping_size);
+		io->in_mapping = NULL;
+		io->in_mapping_size = 0;
+
+		io->in_buffer = NULL;
+		io->in_size = 0;
+	}
+
 	io->in_position = 0;
 
 	return ret;
@@ -440,6 +1001,19 @@ int in_clear(universal_io *const io)
 	{
 		in_close_file(io);
 	}
+	else if (in_is_stream(io))
+	{
+		free(io->in_received);
+		io->in_received = NULL;
+		io->in_received_size = 0;
+		io->in_offset = 0;
+		io->in_stream = NULL;
+
+		io->in_buffer = NULL;
+
+		io->in_size = 0;
+		io->in_position = 0;
+	}
 	else if (in_is_buffer(io))
 	{
 		io->in_buffer = NULL;
@@ -470,6 +1044,13 @@ int out_set_file(universal_io *const io, const char *const path)
 		return -1;
 	}
 
+	// Output goes to disk in large blocks, block is optional for correctness
+	io->out_block = malloc(OUT_BLOCK_SIZE * sizeof(char));
+	if (io->out_block != NULL)
+	{
+		setvbuf(io->out_file, io->out_block, _IOFBF, OUT_BLOCK_SIZE);
+	}
+
 	io->out_func = &out_func_file;
 
 	return 0;
@@ -512,6 +1093,44 @@ int out_set_func(universal_io *const io, const io_user_func func)
 	return 0;
 }
 
+int out_set_stream(universal_io *const io, stream *const strm)
+{
+	if (strm == NULL || out_clear(io))
+	{
+		return -1;
+	}
+
+	io->out_stream = strm;
+	io->out_func = &out_func_stream;
+
+	return 0;
+}
+
+int out_write(universal_io *const io, const char *const data, const size_t size)
+{
+	if (data == NULL)
+	{
+		return -1;
+	}
+
+	if (out_is_file(io))
+	{
+		return fwrite(data, sizeof(char), size, io->out_file) == size ? (int)size : -1;
+	}
+
+	if (out_is_buffer(io))
+	{
+		return out_write_buffer(io, data, size);
+	}
+
+	if (out_is_stream(io))
+	{
+		return stream_write(io->out_stream, data, size) ? -1 : (int)size;
+	}
+
+	return out_is_func(io) ? out_print_func(io, "%.*s", (int)size, data) : -1;
+}
+
 int out_swap(universal_io *const fst, universal_io *const snd)
 {
 	if (fst == NULL || snd == NULL)
@@ -523,6 +1142,10 @@ int out_swap(universal_io *const fst, universal_io *const snd)
 	fst->out_file = snd->out_file;
 	snd->out_file = file;
 
+	char *block = fst->out_block;
+	fst->out_block = snd->out_block;
+	snd->out_block = block;
+
 	char *buffer = fst->out_buffer;
 	fst->out_buffer = snd->out_buffer;
 	snd->out_buffer = buffer;
@@ -535,6 +1158,10 @@ int out_swap(universal_io *const fst, universal_io *const snd)
 	fst->out_position = snd->out_position;
 	snd->out_position = position;
 
+	stream *strm = fst->out_stream;
+	fst->out_stream = snd->out_stream;
+	snd->out_stream = strm;
+
 	const io_user_func user_func = fst->out_user_func;
 	fst->out_user_func = snd->out_user_func;
 	snd->out_user_func = user_func;
@@ -549,7 +1176,7 @@ int out_swap(universal_io *const fst, universal_io *const snd)
 
 bool out_is_correct(const universal_io *const io)
 {
-	return io != NULL && (out_is_file(io) || out_is_buffer(io) || out_is_func(io));;
+	return io != NULL && (out_is_file(io) || out_is_buffer(io) || out_is_stream(io) || out_is_func(io));
 }
 
 bool out_is_file(const universal_io *const io)
@@ -567,6 +1194,11 @@ bool out_is_func(const universal_io *const io)
 	return io != NULL && io->out_user_func != NULL;
 }
 
+bool out_is_stream(const universal_io *const io)
+{
+	return io != NULL && io->out_stream != NULL;
+}
+
 
 io_func out_get_func(const universal_io *const io)
 {
@@ -611,6 +1243,9 @@ int out_close_file(universal_io *const io)
 	int ret = fclose(io->out_file);
 	io->out_file = NULL;
 
+	free(io->out_block);
+	io->out_block = NULL;
+
 	return ret;
 }
 
@@ -629,6 +1264,10 @@ int out_clear(universal_io *const io)
 	{
 		free(out_extract_buffer(io));
 	}
+	else if (out_is_stream(io))
+	{
+		io->out_stream = NULL;
+	}
 	else
 	{
 		io->out_user_func = NULL;
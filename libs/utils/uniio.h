@@ -21,6 +21,7 @@
 #include <stddef.h>
 #include <stdio.h>
 #include "dll.h"
+#include "stream.h"
 #include "utf8.h"
 
 
@@ -58,19 +59,29 @@ struct universal_io
 {
 	FILE *in_file;				/**< Input file */
 	const char *in_buffer;		/**< Input buffer */
+	char *in_mapping;			/**< Memory mapped input file */
+	size_t in_mapping_size;		/**< Size of memory mapping, @c 0 for heap copy */
 
 	size_t in_size;				/**< Size of input buffer */
 	size_t in_position;			/**< Current position of input buffer */
 
+	stream *in_stream;			/**< Input stream, received text is kept in input buffer */
+	char *in_received;			/**< Text received from input stream */
+	size_t in_received_size;	/**< Allocated size of received text */
+	size_t in_offset;			/**< Position of received text in input stream */
+
 	io_user_func in_user_func;	/**< Input user function */
 	io_func in_func;			/**< Current input function */
 
 	FILE *out_file;				/**< Output file */
+	char *out_block;			/**< Block buffer of output file */
 	char *out_buffer;			/**< Output buffer */
 
 	size_t out_size;			/**< Size of output buffer */
 	size_t out_position;		/**< Current position of output buffer */
 
+	stream *out_stream;			/**< Output stream */
+
 	io_user_func out_user_func;	/**< Output user function */
 	io_func out_func;			/**< Current output function */
 };
@@ -94,6 +105,25 @@ EXPORTED universal_io io_create(void);
  */
 EXPORTED int in_set_file(universal_io *const io, const char *const path);
 
+/**
+ *	Set input file mapped into memory as a whole
+ *
+ *	@param	io			Universal io structure
+ *	@param	path		Input file path
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int in_set_mmap(universal_io *const io, const char *const path);
+
+/**
+ *	Map opened input file into memory as a whole, current position is kept
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int in_map_file(universal_io *const io);
+
 /**
  *	Set input buffer
  *
@@ -114,6 +144,17 @@ EXPORTED int in_set_buffer(universal_io *const io, const char *const buffer);
  */
 EXPORTED int in_set_func(universal_io *const io, const io_user_func func);
 
+/**
+ *	Set input stream, received text is kept back to the last @c #line mark with path
+ *	at least one chunk before current position to allow returns to previous positions
+ *
+ *	@param	io			Universal io structure
+ *	@param	strm		Input stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int in_set_stream(universal_io *const io, stream *const strm);
+
 /**
  *	Set input position
  *
@@ -134,6 +175,15 @@ EXPORTED int in_set_position(universal_io *const io, const size_t position);
  */
 EXPORTED int in_swap(universal_io *const fst, universal_io *const snd);
 
+/**
+ *	Receive the rest of input stream, so that its producer finishes
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	@c 0 on success, @c -1 if input is not stream or its text is incomplete
+ */
+EXPORTED int in_receive_rest(universal_io *const io);
+
 
 /**
  *	Check that current input option is correct
@@ -162,6 +212,15 @@ EXPORTED bool in_is_file(const universal_io *const io);
  */
 EXPORTED bool in_is_buffer(const universal_io *const io);
 
+/**
+ *	Check that current input option is memory mapped file
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+EXPORTED bool in_is_mmap(const universal_io *const io);
+
 /**
  *	Check that current input option is function
  *
@@ -171,6 +230,15 @@ EXPORTED bool in_is_buffer(const universal_io *const io);
  */
 EXPORTED bool in_is_func(const universal_io *const io);
 
+/**
+ *	Check that current input option is stream
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+EXPORTED bool in_is_stream(const universal_io *const io);
+
 
 /**
  *	Get input func from universal io structure
@@ -210,6 +278,44 @@ EXPORTED const char *in_get_buffer(const universal_io *const io);
 EXPORTED size_t in_get_position(const universal_io *const io);
 
 
+/**
+ *	Scan next UTF-8 character from input
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	UTF-8 character, @c EOF on end of input
+ */
+EXPORTED char32_t in_next_char(universal_io *const io);
+
+/**
+ *	Peek next UTF-8 character from input without moving position
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	UTF-8 character, @c EOF on end of input or for function input
+ */
+EXPORTED char32_t in_peek_char(universal_io *const io);
+
+/**
+ *	Skip spaces, tabs and newlines in buffer input in blocks
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	@c 0 on success, @c -1 if input is not a buffer or block search is disabled
+ */
+EXPORTED int in_skip_blank(universal_io *const io);
+
+/**
+ *	Skip buffer input in blocks until one or two characters long string
+ *
+ *	@param	io			Universal io structure
+ *	@param	str			String to find, position is set to its beginning or to the end of input
+ *
+ *	@return	@c 0 on success, @c -1 if input is not a buffer or block search is disabled
+ */
+EXPORTED int in_skip_until(universal_io *const io, const char *const str);
+
+
 /**
  *	Close input file
  *
@@ -259,6 +365,27 @@ EXPORTED int out_set_buffer(universal_io *const io, const size_t size);
  */
 EXPORTED int out_set_func(universal_io *const io, const io_user_func func);
 
+/**
+ *	Set output stream
+ *
+ *	@param	io			Universal io structure
+ *	@param	strm		Output stream
+ *
+ *	@return	@c 0 on success, @c -1 on failure
+ */
+EXPORTED int out_set_stream(universal_io *const io, stream *const strm);
+
+/**
+ *	Write data to output without format parsing
+ *
+ *	@param	io			Universal io structure
+ *	@param	data		Data to write
+ *	@param	size		Size of data
+ *
+ *	@return	Number of written characters, @c -1 on failure
+ */
+EXPORTED int out_write(universal_io *const io, const char *const data, const size_t size);
+
 /**
  *	Swap output option between two streams
  *
@@ -306,6 +433,15 @@ EXPORTED bool out_is_buffer(const universal_io *const io);
  */
 EXPORTED bool out_is_func(const universal_io *const io);
 
+/**
+ *	Check that current output option is stream
+ *
+ *	@param	io			Universal io structure
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+EXPORTED bool out_is_stream(const universal_io *const io);
+
 
 /**
  *	Get output function from universal io structure
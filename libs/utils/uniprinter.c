@@ -16,6 +16,7 @@
 
 #include "uniprinter.h"
 #include <stdarg.h>
+#include <string.h>
 #include "utf8.h"
 
 
@@ -38,12 +39,56 @@ int uni_printf(universal_io *const io, const char *const format, ...)
 
 int uni_print_char(universal_io *const io, const char32_t wchar)
 {
-	char buffer[8];
+	if (wchar == '\0')
+	{
+		return 0;
+	}
 
-	if (!utf8_to_string(buffer, wchar))
+	if (wchar < 0x80)
+	{
+		const char symbol = (char)wchar;
+		return out_write(io, &symbol, 1);
+	}
+
+	char buffer[8];
+	const size_t size = utf8_to_string(buffer, wchar);
+	if (!size)
 	{
 		return 0;
 	}
 
-	return uni_printf(io, "%s", buffer);
+	return out_write(io, buffer, size);
+}
+
+int uni_print_str(universal_io *const io, const char *const str)
+{
+	return str != NULL ? out_write(io, str, strlen(str)) : -1;
+}
+
+int uni_print_item(universal_io *const io, const item_t item)
+{
+	char buffer[24];
+	size_t index = sizeof(buffer);
+
+#if ITEM < 0
+	const bool is_negative = item < 0;
+	// Negate in unsigned domain to keep ITEM_MIN representable
+	uint64_t value = is_negative ? (uint64_t)0 - (uint64_t)item : (uint64_t)item;
+#else
+	const bool is_negative = false;
+	uint64_t value = item;
+#endif
+
+	do
+	{
+		buffer[--index] = (char)('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+
+	if (is_negative)
+	{
+		buffer[--index] = '-';
+	}
+
+	return out_write(io, &buffer[index], sizeof(buffer) - index);
 }
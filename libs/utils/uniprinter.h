@@ -18,6 +18,7 @@
 
 #include <stdio.h>
 #include "dll.h"
+#include "item.h"
 #include "uniio.h"
 
 
@@ -47,6 +48,26 @@ EXPORTED int uni_printf(universal_io *const io, const char *const format, ...)
  */
 EXPORTED int uni_print_char(universal_io *const io, const char32_t wchar);
 
+/**
+ *	Universal function for printing strings without format parsing
+ *
+ *	@param	io			Universal io structure
+ *	@param	str			NULL-terminated string
+ *
+ *	@return	Return printf-like value
+ */
+EXPORTED int uni_print_str(universal_io *const io, const char *const str);
+
+/**
+ *	Universal function for printing items without format parsing
+ *
+ *	@param	io			Universal io structure
+ *	@param	item		Item in decimal form
+ *
+ *	@return	Return printf-like value
+ */
+EXPORTED int uni_print_item(universal_io *const io, const item_t item);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -39,22 +39,7 @@ int uni_scanf(universal_io *const io, const char *const format, ...)
 
 char32_t uni_scan_char(universal_io *const io)
 {
-	char buffer[MAX_SYMBOL_SIZE];
-	if (!uni_scanf(io, "%c", &buffer[0]))
-	{
-		return (char32_t)EOF;
-	}
-
-	const size_t size = utf8_symbol_size(buffer[0]);
-	for (size_t i = 1; i < size; i++)
-	{
-		if (!uni_scanf(io, "%c", &buffer[i]))
-		{
-			return (char32_t)EOF;
-		}
-	}
-
-	return utf8_convert(buffer);
+	return in_next_char(io);
 }
 
 size_t uni_scan_number(universal_io *const io, char *const buffer)
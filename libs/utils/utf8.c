@@ -18,6 +18,15 @@
 #include <assert.h>
 
 
+EXPORTED extern uint8_t utf8_get_class(const char32_t symbol);
+
+EXPORTED extern bool utf8_is_russian(const char32_t symbol);
+EXPORTED extern bool utf8_is_letter(const char32_t symbol);
+EXPORTED extern bool utf8_is_digit(const char32_t symbol);
+EXPORTED extern bool utf8_is_hexa_digit(const char32_t symbol);
+EXPORTED extern bool utf8_is_power(const char32_t symbol);
+
+
 static char32_t char32_from_cp866(const unsigned char symbol)
 {
 	if (symbol < 0x80)
@@ -1093,35 +1102,3 @@ uint8_t utf8_to_number(const char32_t symbol)
 
 	return 0;
 }
-
-bool utf8_is_russian(const char32_t symbol)
-{
-	return  symbol == U'Ё' || symbol == U'ё'
-		|| (symbol >= U'А' && symbol <= U'Я')
-		|| (symbol >= U'а' && symbol <= U'п')
-		|| (symbol >= U'р' && symbol <= U'я');
-}
-
-bool utf8_is_letter(const char32_t symbol)
-{
-	return  utf8_is_russian(symbol) || symbol == '_'
-		|| (symbol >= 'A' && symbol <= 'Z')
-		|| (symbol >= 'a' && symbol <= 'z');
-}
-
-bool utf8_is_digit(const char32_t symbol)
-{
-	return symbol >= '0' && symbol <= '9';
-}
-
-bool utf8_is_hexa_digit(const char32_t symbol)
-{
-	return utf8_is_digit(symbol)
-		|| (symbol >= 'A' && symbol <= 'F')
-		|| (symbol >= 'a' && symbol <= 'f');
-}
-
-bool utf8_is_power(const char32_t symbol)
-{
-	return symbol == 'e' || symbol == 'E' || symbol == U'е' || symbol == U'Е';
-}
@@ -149,6 +149,68 @@ EXPORTED char32_t utf8_to_upper(const char32_t symbol);
  */
 EXPORTED uint8_t utf8_to_number(const char32_t symbol);
 
+/** Character classes */
+enum UTF8_CLASS
+{
+	UTF8_LETTER = 1 << 0,		/**< English or russian letter, '_' */
+	UTF8_DIGIT = 1 << 1,		/**< Decimal digit */
+	UTF8_HEXA_DIGIT = 1 << 2,	/**< Hexadecimal digit */
+	UTF8_POWER = 1 << 3,		/**< Exponent letter */
+};
+
+
+/**
+ *	Get classes of сharacter
+ *
+ *	@param	symbol	UTF-8 сharacter
+ *
+ *	@return	Bit set of @c UTF8_CLASS values
+ */
+inline uint8_t utf8_get_class(const char32_t symbol)
+{
+	static const uint8_t ascii[256] =
+	{
+		/* 0x00 */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+		/* 0x10 */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+		/* 0x20 */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+		/* 0x30 */  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  0,  0,  0,  0,  0,  0,
+		/* 0x40 */  0,  5,  5,  5,  5, 13,  5,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+		/* 0x50 */  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  0,  0,  0,  0,  1,
+		/* 0x60 */  0,  5,  5,  5,  5, 13,  5,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+		/* 0x70 */  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  0,  0,  0,  0,  0,
+		/* 0x80 */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+		/* 0x90 */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+		/* 0xA0 */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+		/* 0xB0 */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+		/* 0xC0 */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+		/* 0xD0 */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+		/* 0xE0 */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+		/* 0xF0 */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+	};
+
+	static const char32_t russian[][2] =
+	{
+		{ U'Ё', U'Ё' },
+		{ U'А', U'я' },
+		{ U'ё', U'ё' },
+	};
+
+	if (symbol < 256)
+	{
+		return ascii[symbol];
+	}
+
+	for (size_t i = 0; i < sizeof(russian) / sizeof(russian[0]); i++)
+	{
+		if (symbol >= russian[i][0] && symbol <= russian[i][1])
+		{
+			return symbol == U'Е' || symbol == U'е' ? UTF8_LETTER | UTF8_POWER : UTF8_LETTER;
+		}
+	}
+
+	return 0;
+}
+
 /**
  *	Check if сharacter is russian letter
  *
@@ -156,7 +218,10 @@ EXPORTED uint8_t utf8_to_number(const char32_t symbol);
  *
  *	@return	@c 1 on true, @c 0 on false
  */
-EXPORTED bool utf8_is_russian(const char32_t symbol);
+inline bool utf8_is_russian(const char32_t symbol)
+{
+	return symbol >= 256 && (utf8_get_class(symbol) & UTF8_LETTER) != 0;
+}
 
 /**
  *	Check if сharacter is english or russian letter
@@ -165,7 +230,10 @@ EXPORTED bool utf8_is_russian(const char32_t symbol);
  *
  *	@return	@c 1 on true, @c 0 on false
  */
-EXPORTED bool utf8_is_letter(const char32_t symbol);
+inline bool utf8_is_letter(const char32_t symbol)
+{
+	return (utf8_get_class(symbol) & UTF8_LETTER) != 0;
+}
 
 /**
  *	Check if сharacter is decimal digit
@@ -174,7 +242,10 @@ EXPORTED bool utf8_is_letter(const char32_t symbol);
  *
  *	@return	@c 1 on true, @c 0 on false
  */
-EXPORTED bool utf8_is_digit(const char32_t symbol);
+inline bool utf8_is_digit(const char32_t symbol)
+{
+	return (utf8_get_class(symbol) & UTF8_DIGIT) != 0;
+}
 
 /**
  *	Check if сharacter is hexadecimal digit
@@ -183,7 +254,10 @@ EXPORTED bool utf8_is_digit(const char32_t symbol);
  *
  *	@return	@c 1 on true, @c 0 on false
  */
-EXPORTED bool utf8_is_hexa_digit(const char32_t symbol);
+inline bool utf8_is_hexa_digit(const char32_t symbol)
+{
+	return (utf8_get_class(symbol) & UTF8_HEXA_DIGIT) != 0;
+}
 
 /**
  *	Check if сharacter is 'E', 'e', 'Е' or 'е'
@@ -192,7 +266,10 @@ EXPORTED bool utf8_is_hexa_digit(const char32_t symbol);
  *
  *	@return	@c 1 on true, @c 0 on false
  */
-EXPORTED bool utf8_is_power(const char32_t symbol);
+inline bool utf8_is_power(const char32_t symbol)
+{
+	return (utf8_get_class(symbol) & UTF8_POWER) != 0;
+}
 
 #ifdef __cplusplus
 } /* extern "C" */
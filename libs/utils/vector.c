@@ -19,12 +19,21 @@
 #include <string.h>
 
 
+extern size_t vector_size(const vector *const vec);
+extern bool vector_is_correct(const vector *const vec);
+
+extern item_t vector_at(const vector *const vec, const size_t index);
+extern item_t *vector_at_mut(vector *const vec, const size_t index);
+extern size_t vector_push_unchecked(vector *const vec, const item_t value);
+
+
 static int change_size(vector *const vec, const size_t size)
 {
 	if (size > vec->size_alloc)
 	{
 		const size_t alloc_new = size > 2 * vec->size_alloc ? size : 2 * vec->size_alloc;
-		item_t *array_new = realloc(vec->array, alloc_new * sizeof(item_t));
+		item_t *array_new = arena_reallocate(vec->region, vec->array
+			, vec->size_alloc * sizeof(item_t), alloc_new * sizeof(item_t));
 		if (array_new == NULL)
 		{
 			return -1;
@@ -54,12 +63,18 @@ static int change_size(vector *const vec, const size_t size)
 
 
 vector vector_create(const size_t alloc)
+{
+	return vector_create_in(NULL, alloc);
+}
+
+vector vector_create_in(arena *const region, const size_t alloc)
 {
 	vector vec;
 
 	vec.size = 0;
 	vec.size_alloc = alloc != 0 ? alloc : 1;
-	vec.array = malloc(vec.size_alloc * sizeof(item_t));
+	vec.region = region;
+	vec.array = arena_allocate(region, vec.size_alloc * sizeof(item_t));
 
 	return vec;
 }
@@ -205,16 +220,6 @@ int vector_resize(vector *const vec, const size_t size)
 	return vector_is_correct(vec) ? change_size(vec, size) : -1;
 }
 
-size_t vector_size(const vector *const vec)
-{
-	return vector_is_correct(vec) ? vec->size : SIZE_MAX;
-}
-
-bool vector_is_correct(const vector *const vec)
-{
-	return vec != NULL && vec->array != NULL;
-}
-
 
 int vector_clear(vector *const vec)
 {
@@ -223,7 +228,7 @@ int vector_clear(vector *const vec)
 		return -1;
 	}
 
-	free(vec->array);
+	arena_free(vec->region, vec->array);
 	vec->array = NULL;
 
 	return 0;
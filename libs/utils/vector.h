@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <assert.h>
+#include "arena.h"
 #include "dll.h"
 #include "item.h"
 
@@ -30,6 +32,7 @@ typedef struct vector
 	item_t *array;				/**< Vector array */
 	size_t size;				/**< Size of vector */
 	size_t size_alloc;			/**< Allocated size of vector */
+	arena *region;				/**< Memory region, @c NULL for heap */
 } vector;
 
 
@@ -42,6 +45,16 @@ typedef struct vector
  */
 EXPORTED vector vector_create(const size_t alloc);
 
+/**
+ *	Create new vector in memory region
+ *
+ *	@param	region			Memory region, @c NULL for heap
+ *	@param	alloc			Initializer of allocated size
+ *
+ *	@return	Vector structure
+ */
+EXPORTED vector vector_create_in(arena *const region, const size_t alloc);
+
 
 /**
  *	Add new value
@@ -187,6 +200,18 @@ EXPORTED int vector_increase(vector *const vec, const size_t size);
  */
 EXPORTED int vector_resize(vector *const vec, const size_t size);
 
+/**
+ *	Check that vector is correct
+ *
+ *	@param	vec				Vector structure
+ *
+ *	@return	@c 1 on true, @c 0 on false
+ */
+inline bool vector_is_correct(const vector *const vec)
+{
+	return vec != NULL && vec->array != NULL;
+}
+
 /**
  *	Get vector size
  *
@@ -194,16 +219,59 @@ EXPORTED int vector_resize(vector *const vec, const size_t size);
  *
  *	@return	Size of vector, @c SIZE_MAX on failure
  */
-EXPORTED size_t vector_size(const vector *const vec);
+inline size_t vector_size(const vector *const vec)
+{
+	return vector_is_correct(vec) ? vec->size : SIZE_MAX;
+}
+
 
 /**
- *	Check that vector is correct
+ *	Get value without checks, index must be less than size
+ *
+ *	@param	vec				Vector structure
+ *	@param	index			Index
+ *
+ *	@return	Value
+ */
+inline item_t vector_at(const vector *const vec, const size_t index)
+{
+	assert(vector_is_correct(vec) && index < vec->size);
+	return vec->array[index];
+}
+
+/**
+ *	Get pointer to value without checks, index must be less than size
  *
  *	@param	vec				Vector structure
+ *	@param	index			Index
  *
- *	@return	@c 1 on true, @c 0 on false
+ *	@return	Pointer to value, valid until the next size change
+ */
+inline item_t *vector_at_mut(vector *const vec, const size_t index)
+{
+	assert(vector_is_correct(vec) && index < vec->size);
+	return &vec->array[index];
+}
+
+/**
+ *	Add new value to correct vector, reallocation is done out of line
+ *
+ *	@param	vec				Vector structure
+ *	@param	value			New value
+ *
+ *	@return	Index, @c SIZE_MAX on failure
  */
-EXPORTED bool vector_is_correct(const vector *const vec);
+inline size_t vector_push_unchecked(vector *const vec, const item_t value)
+{
+	assert(vector_is_correct(vec));
+	if (vec->size == vec->size_alloc)
+	{
+		return vector_add(vec, value);
+	}
+
+	vec->array[vec->size] = value;
+	return vec->size++;
+}
 
 
 /**
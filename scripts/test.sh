@@ -51,6 +51,7 @@ init()
 				echo -e "\t-v, --virtual\tSet RuC virtual machine release."
 				echo -e "\t-o, --output\tSet output printing time (default = 0.0)."
 				echo -e "\t-w, --wait\tSet waiting time for timeout result (default = 2)."
+				echo -e "\t-e, --extra\tPass extra flag to compiler, e.g. -stream or -mmap."
 				exit 0
 				;;
 			-s|--silence)
@@ -80,6 +81,10 @@ init()
 				wait_for=$2
 				shift
 				;;
+			-e|--extra)
+				extra="$extra $2"
+				shift
+				;;
 		esac
 		shift
 	done
@@ -381,7 +386,7 @@ compiling()
 	if [[ -z $ignore || $path != $dir_lexing/* || $path != $dir_preprocessor/* || $path != $dir_semantics/* 
 		|| $path != $dir_syntax/* || $path != $dir_multiple_errors/* || $path != $dir_unsorted/* ]] ; then
 		action="compiling"
-		run $compiler $compiler_debug $sources -o $vm_exec -RISCV
+		run $compiler $compiler_debug $sources $extra -o $vm_exec -RISCV
 
 		case $? in
 			0)
@@ -0,0 +1,12 @@
+void main()
+{
+	const int i = 7;
+	const float f = 2.5;
+	const char c = 'a';
+	const bool b = true;
+
+	assert(i % 2 == 1, "const int must be 7");
+	assert(f > 2.4 && f < 2.6, "const float must be 2.5");
+	assert(c % 2 == 1, "const char must be 'a'");
+	assert(b, "const bool must be true");
+}
@@ -0,0 +1,3 @@
+// Header next to main file
+
+#define HEADER_PLACE 1
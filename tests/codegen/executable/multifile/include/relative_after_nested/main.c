@@ -0,0 +1,10 @@
+#include "nested/nested.h"
+#include "header.h"
+
+
+void main()
+{
+	nested_var = HEADER_PLACE;
+
+	assert(nested_var == 1, "header.h must be searched next to main.c");
+}
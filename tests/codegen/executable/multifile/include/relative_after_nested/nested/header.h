@@ -0,0 +1,3 @@
+// Header with the same name in nested directory
+
+#define HEADER_PLACE 2
@@ -0,0 +1,3 @@
+// Nested header includes nothing, but changes current file
+
+int nested_var = 0;
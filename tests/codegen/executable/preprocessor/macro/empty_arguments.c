@@ -0,0 +1,13 @@
+#define ID(x) x
+#define PAIR(a, b) a b
+
+void main()
+{
+	int i = 1 ID();
+	int j = 2 ID( );
+	int k = PAIR(, 3) + PAIR( 4, ) PAIR( , );
+
+	assert(i == 1, "ID() must be empty");
+	assert(j == 2, "ID( ) must be empty");
+	assert(k == 7, "empty PAIR arguments must be empty");
+}
@@ -0,0 +1,86 @@
+struct wide
+{
+	int m0;
+	int m1;
+	int m2;
+	float m3;
+	int m4;
+	int m5;
+	int m6;
+	float m7;
+	int m8;
+	int m9;
+	int m10;
+	float m11;
+	int m12;
+	int m13;
+	int m14;
+	float m15;
+	int m16;
+	int m17;
+	int m18;
+	float m19;
+	int m20;
+	int m21;
+	int m22;
+	float m23;
+	int m24;
+	int m25;
+	int m26;
+	float m27;
+	int m28;
+	int m29;
+	int m30;
+	float m31;
+	int m32;
+	int m33;
+	int m34;
+	float m35;
+	int m36;
+	int m37;
+	int m38;
+	float m39;
+	int m40;
+	int m41;
+	int m42;
+	float m43;
+	int m44;
+	int m45;
+	int m46;
+	float m47;
+	int m48;
+	int m49;
+	int m50;
+	float m51;
+	int m52;
+	int m53;
+	int m54;
+	float m55;
+	int m56;
+	int m57;
+	int m58;
+	float m59;
+	int m60;
+	int m61;
+	int m62;
+	float m63;
+};
+
+
+void main()
+{
+	struct wide w;
+	w.m0 = 1;
+	w.m48 = 49;
+	w.m62 = 63;
+	w.m63 = 6.5;
+
+	assert(w.m0 == 1, "w.m0 != 1");
+	assert(w.m48 == 49, "w.m48 != 49");
+	assert(w.m62 == 63, "w.m62 != 63");
+	assert(w.m63 > 6.4, "w.m63 != 6.5");
+	assert(w.m63 < 6.6, "w.m63 != 6.5");
+
+	struct wide *p = &w;
+	assert(p->m62 == 63, "p->m62 != 63");
+}
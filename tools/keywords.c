@@ -0,0 +1,245 @@
+/*
+ *	Copyright 2026 Andrey Terekhov
+ *
+ *	Licensed under the Apache License, Version 2.0 (the "License");
+ *	you may not use this file except in compliance with the License.
+ *	You may obtain a copy of the License at
+ *
+ *		http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *	Unless required by applicable law or agreed to in writing, software
+ *	distributed under the License is distributed on an "AS IS" BASIS,
+ *	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *	See the License for the specific language governing permissions and
+ *	limitations under the License.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "keywords.h"
+#include "utf8.h"
+
+
+#define MAX_SPELLINGS 1024
+#define MAX_SPELLING_SIZE 256
+#define MAX_SEED 1000000
+
+#define KEYWORDS_SIZE 512
+#define KEYWORDS_BUCKETS 128
+
+
+extern uint32_t keyword_hash(const char *const spelling, const size_t length, const uint32_t seed);
+
+
+/** Spelling of keyword or builtin function */
+typedef struct spelling
+{
+	char text[MAX_SPELLING_SIZE];	/**< Spelling in UTF-8 */
+	size_t length;					/**< Spelling length in bytes */
+	const char *reference;			/**< Name of keyword token or builtin function identifier */
+} spelling;
+
+/** Generator state */
+typedef struct generator
+{
+	spelling spellings[MAX_SPELLINGS];	/**< Unique spellings */
+	size_t size;						/**< Number of spellings */
+
+	size_t table[KEYWORDS_SIZE];		/**< Spelling index of table slot, @c SIZE_MAX for empty */
+	uint32_t seeds[KEYWORDS_BUCKETS];	/**< Seed of bucket */
+} generator;
+
+
+static generator gen;
+
+
+static void add_spelling(const char32_t *const name, const bool is_upper, const char *const reference)
+{
+	spelling *const current = &gen.spellings[gen.size];
+	current->length = 0;
+	for (size_t i = 0; name[i] != '\0'; i++)
+	{
+		current->length += utf8_to_string(&current->text[current->length], is_upper ? utf8_to_upper(name[i]) : name[i]);
+	}
+
+	// Как и при заполнении таблицы representations, остаётся первое написание
+	for (size_t i = 0; i < gen.size; i++)
+	{
+		if (gen.spellings[i].length == current->length && memcmp(gen.spellings[i].text, current->text, current->length) == 0)
+		{
+			return;
+		}
+	}
+
+	current->reference = reference;
+	gen.size++;
+}
+
+static void add_names(const char *const reference, const char32_t *const eng, const char32_t *const rus)
+{
+	add_spelling(eng, false, reference);
+	add_spelling(eng, true, reference);
+	add_spelling(rus, false, reference);
+	add_spelling(rus, true, reference);
+}
+
+
+static int compare_buckets(const void *const fst, const void *const snd)
+{
+	const size_t *const fst_bucket = fst;
+	const size_t *const snd_bucket = snd;
+	return (int)snd_bucket[1] - (int)fst_bucket[1];
+}
+
+static bool try_seed(const size_t bucket, const uint32_t seed)
+{
+	size_t slots[MAX_SPELLINGS];
+	size_t amount = 0;
+
+	for (size_t i = 0; i < gen.size; i++)
+	{
+		const spelling *const current = &gen.spellings[i];
+		if (keyword_hash(current->text, current->length, 0) % KEYWORDS_BUCKETS != bucket)
+		{
+			continue;
+		}
+
+		const size_t slot = keyword_hash(current->text, current->length, seed) % KEYWORDS_SIZE;
+		if (gen.table[slot] != SIZE_MAX)
+		{
+			return false;
+		}
+
+		for (size_t j = 0; j < amount; j++)
+		{
+			if (slots[j] == slot)
+			{
+				return false;
+			}
+		}
+
+		slots[amount++] = slot;
+	}
+
+	amount = 0;
+	for (size_t i = 0; i < gen.size; i++)
+	{
+		const spelling *const current = &gen.spellings[i];
+		if (keyword_hash(current->text, current->length, 0) % KEYWORDS_BUCKETS == bucket)
+		{
+			gen.table[slots[amount++]] = i;
+		}
+	}
+
+	gen.seeds[bucket] = seed;
+	return true;
+}
+
+static int build_table(void)
+{
+	size_t buckets[KEYWORDS_BUCKETS][2];
+	for (size_t i = 0; i < KEYWORDS_BUCKETS; i++)
+	{
+		buckets[i][0] = i;
+		buckets[i][1] = 0;
+		gen.seeds[i] = 0;
+	}
+
+	for (size_t i = 0; i < gen.size; i++)
+	{
+		buckets[keyword_hash(gen.spellings[i].text, gen.spellings[i].length, 0) % KEYWORDS_BUCKETS][1]++;
+	}
+
+	for (size_t i = 0; i < KEYWORDS_SIZE; i++)
+	{
+		gen.table[i] = SIZE_MAX;
+	}
+
+	// Сначала размещаются самые большие корзины
+	qsort(buckets, KEYWORDS_BUCKETS, sizeof(buckets[0]), &compare_buckets);
+	for (size_t i = 0; i < KEYWORDS_BUCKETS && buckets[i][1] != 0; i++)
+	{
+		uint32_t seed = 1;
+		while (!try_seed(buckets[i][0], seed))
+		{
+			if (++seed == MAX_SEED)
+			{
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int print_table(FILE *const file)
+{
+	size_t max_length = 0;
+	for (size_t i = 0; i < gen.size; i++)
+	{
+		max_length = gen.spellings[i].length > max_length ? gen.spellings[i].length : max_length;
+	}
+
+	fprintf(file, "/* Generated from keywords.def by keywords-generator, do not edit */\n\n");
+	fprintf(file, "#define KEYWORDS_SIZE %d\n", KEYWORDS_SIZE);
+	fprintf(file, "#define KEYWORDS_BUCKETS %d\n", KEYWORDS_BUCKETS);
+	fprintf(file, "#define KEYWORDS_MAX_LENGTH %zu\n\n\n", max_length);
+
+	fprintf(file, "static const uint32_t keywords_seeds[KEYWORDS_BUCKETS] =\n{");
+	for (size_t i = 0; i < KEYWORDS_BUCKETS; i++)
+	{
+		fprintf(file, "%s%u,", i % 16 == 0 ? "\n\t" : " ", gen.seeds[i]);
+	}
+	fprintf(file, "\n};\n\n");
+
+	fprintf(file, "static const keyword keywords_table[KEYWORDS_SIZE] =\n{\n");
+	for (size_t i = 0; i < KEYWORDS_SIZE; i++)
+	{
+		if (gen.table[i] == SIZE_MAX)
+		{
+			fprintf(file, "\t{ \"\", 0, 0 },\n");
+			continue;
+		}
+
+		const spelling *const current = &gen.spellings[gen.table[i]];
+		fprintf(file, "\t{ \"%.*s\", %zu, %s },\n", (int)current->length, current->text, current->length, current->reference);
+	}
+	fprintf(file, "};\n");
+
+	return ferror(file) ? -1 : 0;
+}
+
+
+int main(int argc, const char *argv[])
+{
+	if (argc != 2)
+	{
+		fprintf(stderr, "usage: %s <output>\n", argv[0]);
+		return 1;
+	}
+
+	#define KEYWORD(token, eng, rus) add_names(#token, eng, rus);
+	#define BUILTIN(identifier, eng, rus, type) add_names(#identifier, eng, rus);
+	#include "keywords.def"
+	#undef KEYWORD
+	#undef BUILTIN
+
+	if (build_table())
+	{
+		fprintf(stderr, "cannot build perfect hash table\n");
+		return 1;
+	}
+
+	FILE *const file = fopen(argv[1], "w");
+	if (file == NULL)
+	{
+		fprintf(stderr, "cannot open %s\n", argv[1]);
+		return 1;
+	}
+
+	const int ret = print_table(file);
+	fclose(file);
+	return ret ? 1 : 0;
+}